@@ -23,7 +23,7 @@ void setPinConfigurationOverrides() { }
 //#if ! ENABLE_PERF_TRACE
 void irqEnterHook() {}
 void irqExitHook() {}
-void contextSwitchHook() {}
+void contextSwitchHook(void*) {}
 void threadInitHook(void*) {}
 void onLockHook() {}
 void onUnlockHook() {}
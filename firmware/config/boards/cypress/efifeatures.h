@@ -31,6 +31,7 @@
 #endif /* EFI_ENABLE_ASSERTS */
 
 #define EFI_TEXT_LOGGING TRUE
+#define EFI_BINARY_LOGGING FALSE
 
 //#define EFI_UART_ECHO_TEST_MODE FALSE
 
@@ -75,6 +76,7 @@
 
 #define EFI_SIGNAL_EXECUTOR_SLEEP FALSE
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER TRUE
+#define EFI_LOW_PRIORITY_SCHEDULER FALSE
 
 #define FUEL_MATH_EXTREME_LOGGING FALSE
 
@@ -335,6 +337,7 @@
 #define EXTREME_TERM_LOGGING FALSE
 #define EFI_PRINTF_FUEL_DETAILS FALSE
 #define ENABLE_PERF_TRACE FALSE
+#define EFI_THREAD_PROFILER FALSE
 
 #define RAM_UNUSED_SIZE 1
 #define CCM_UNUSED_SIZE 1
@@ -91,6 +91,11 @@
 #define EFI_TEXT_LOGGING TRUE
 #endif
 
+// efiPrintf could send raw arguments instead of formatted text, see "binarylog" command
+#ifndef EFI_BINARY_LOGGING
+#define EFI_BINARY_LOGGING EFI_TEXT_LOGGING
+#endif
+
 #define EFI_ACTIVE_CONFIGURATION_IN_FLASH FALSE
 
 #ifndef EFI_MC33816
@@ -125,6 +130,12 @@
 #define EFI_CLOCK_LOCKS TRUE
 #endif
 
+// per-thread CPU load, stack usage and periodic controller deadline misses, see thread_profiler.cpp
+// only where ChibiOS keeps thread time and stack fill pattern, some boards turn those off
+#ifndef EFI_THREAD_PROFILER
+#define EFI_THREAD_PROFILER (CH_DBG_THREADS_PROFILING && CH_DBG_FILL_THREADS)
+#endif
+
 //#define EFI_UART_ECHO_TEST_MODE TRUE
 
 /**
@@ -189,6 +200,12 @@
 #define EFI_SIGNAL_EXECUTOR_SLEEP FALSE
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER TRUE
 
+#ifndef EFI_LOW_PRIORITY_SCHEDULER
+// software PWM gets its own queue on the second compare channel of the scheduler timer
+// note that both channels share one interrupt priority, see microsecond_timer_stm32.cpp
+#define EFI_LOW_PRIORITY_SCHEDULER TRUE
+#endif
+
 #define FUEL_MATH_EXTREME_LOGGING FALSE
 
 #define SPARK_EXTREME_LOGGING FALSE
@@ -59,5 +59,10 @@
 #define EFI_FLASH_WRITE_THREAD TRUE
 #endif
 
+// F7 and H7 CRC unit is flexible enough for zlib CRC32, see stm32_crc.cpp
+#ifndef EFI_HW_CRC32
+#define EFI_HW_CRC32 TRUE
+#endif
+
 // note order of include - first we set F7 defaults (above) and only later we apply F4 defaults
 #include "../stm32f4ems/efifeatures.h"
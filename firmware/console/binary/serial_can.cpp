@@ -26,6 +26,7 @@
 #include "serial_can.h"
 #include "can.h"
 #include "can_msg_tx.h"
+#include "fast_crc32.h"
 #endif // HAL_USE_CAN || EFI_UNIT_TEST
 
 
@@ -37,6 +38,27 @@ static CanTsListener listener;
 
 #if HAL_USE_CAN || EFI_UNIT_TEST
 
+int getIsoTpSeparationTimeUs(int separationTime) {
+	if (separationTime <= 0x7F) {
+		return separationTime * 1000;
+	}
+	if (separationTime >= 0xF1 && separationTime <= 0xF9) {
+		return (separationTime - 0xF0) * 100;
+	}
+	return 0x7F * 1000;
+}
+
+static void waitSeparationTime(int separationTime) {
+#if EFI_PROD_CODE || EFI_SIMULATOR
+	if (separationTime != 0) {
+		chThdSleepMicroseconds(getIsoTpSeparationTimeUs(separationTime));
+	}
+#else
+	// unit tests have no bus to wait for
+	(void)separationTime;
+#endif
+}
+
 int CanStreamerState::sendFrame(const IsoTpFrameHeader & header, const uint8_t *data, int num, can_sysinterval_t timeout) {
 	int dlc = 8; // standard 8 bytes
 	CanTxMessage txmsg(CanCategory::SERIAL, CAN_ECU_SERIAL_TX_ID, dlc, /*bus*/0, IS_EXT_RANGE_ID(CAN_ECU_SERIAL_TX_ID));
@@ -129,7 +151,7 @@ int CanStreamerState::receiveFrame(CANRxFrame *rxmsg, uint8_t *buf, int num, can
 #if defined(TS_CAN_DEVICE_SHORT_PACKETS_IN_ONE_FRAME)
 	if (frameType == ISO_TP_FRAME_SINGLE) {
 		// restore the CRC on the whole packet
-		uint32_t crc = crc32((void *) srcBuf, numBytesAvailable);
+		uint32_t crc = fastCrc32(srcBuf, numBytesAvailable);
 		// we need a separate buffer for crc because srcBuf may not be word-aligned for direct copy
 		uint8_t crcBuffer[sizeof(uint32_t)];
 		*(uint32_t *) (crcBuffer) = SWAP_UINT32(crc);
@@ -161,19 +183,57 @@ int CanStreamerState::receiveFrame(CANRxFrame *rxmsg, uint8_t *buf, int num, can
 		rxFifoBuf.put(srcBuf[i]);
 	}
 
-	// according to the specs, we need to acknowledge the received multi-frame start frame
-	if (frameType == ISO_TP_FRAME_FIRST) {
-		IsoTpFrameHeader header;
-		header.frameType = ISO_TP_FRAME_FLOW_CONTROL;
-		header.fcFlag = 0;			// = "continue to send"
-		header.blockSize = 0;		// = the remaining "frames" to be sent without flow control or delay
-		header.separationTime = 0;	// = wait 0 milliseconds, send immediately
-		sendFrame(header, nullptr, 0, timeout);
+	// according to the specs, we need to acknowledge the received multi-frame start frame,
+	// and then each block of consecutive frames if we've asked for blocks
+	bool isEndOfBlock = frameType == ISO_TP_FRAME_CONSECUTIVE && rxBlockSize != 0 && --framesTillFlowControl == 0;
+	if (frameType == ISO_TP_FRAME_FIRST || (isEndOfBlock && waitingForNumBytes > 0)) {
+		sendFlowControl(timeout);
 	}
 
 	return numBytesToCopy;
 }
 
+void CanStreamerState::sendFlowControl(can_sysinterval_t timeout) {
+	IsoTpFrameHeader header;
+	header.frameType = ISO_TP_FRAME_FLOW_CONTROL;
+	header.fcFlag = CAN_FLOW_STATUS_OK;				// = "continue to send"
+	header.blockSize = rxBlockSize;					// = the "frames" to be sent before next flow control frame
+	header.separationTime = rxSeparationTime;		// = min delay between the "frames"
+	sendFrame(header, nullptr, 0, timeout);
+
+	framesTillFlowControl = rxBlockSize;
+}
+
+bool CanStreamerState::receiveFlowControl(int &blockSize, int &separationTime, can_sysinterval_t timeout) {
+	CANRxFrame rxmsg;
+	for (int numFcReceived = 0; ; numFcReceived++) {
+		if (streamer->receive(CAN_ANY_MAILBOX, &rxmsg, timeout) != CAN_MSG_OK) {
+#ifdef SERIAL_CAN_DEBUG
+			PRINT("*** ERROR: CAN Flow Control frame not received" PRINT_EOL);
+#endif /* SERIAL_CAN_DEBUG */
+			//warning(ObdCode::CUSTOM_ERR_CAN_COMMUNICATION, "CAN Flow Control frame not received");
+			return false;
+		}
+		receiveFrame(&rxmsg, nullptr, 0, timeout);
+		int flowStatus = rxmsg.data8[0] & 0xf;
+		// if something is not ok
+		if (flowStatus != CAN_FLOW_STATUS_OK) {
+			// if the receiver is not ready yet and asks to wait for the next FC frame (give it 3 attempts)
+			if (flowStatus == CAN_FLOW_STATUS_WAIT_MORE && numFcReceived < 3) {
+				continue;
+			}
+#ifdef SERIAL_CAN_DEBUG
+			efiPrintf("*** ERROR: CAN Flow Control mode not supported");
+#endif /* SERIAL_CAN_DEBUG */
+			//warning(ObdCode::CUSTOM_ERR_CAN_COMMUNICATION, "CAN Flow Control mode not supported");
+			return false;
+		}
+		blockSize = rxmsg.data8[1];
+		separationTime = rxmsg.data8[2];
+		return true;
+	}
+}
+
 int CanStreamerState::sendDataTimeout(const uint8_t *txbuf, int numBytes, can_sysinterval_t timeout) {
 	int offset = 0;
 
@@ -203,58 +263,33 @@ int CanStreamerState::sendDataTimeout(const uint8_t *txbuf, int numBytes, can_sy
 	numBytes -= numSent;
 	int totalNumSent = numSent;
 
-	// get a flow control (FC) frame
-#if !EFI_UNIT_TEST // todo: add FC to unit-tests?
-	CANRxFrame rxmsg;
-	for (int numFcReceived = 0; ; numFcReceived++) {
-		if (streamer->receive(CAN_ANY_MAILBOX, &rxmsg, timeout) != CAN_MSG_OK) {
-#ifdef SERIAL_CAN_DEBUG
-			PRINT("*** ERROR: CAN Flow Control frame not received" PRINT_EOL);
-#endif /* SERIAL_CAN_DEBUG */
-			//warning(ObdCode::CUSTOM_ERR_CAN_COMMUNICATION, "CAN Flow Control frame not received");
+	// send the rest of the data, as many consecutive frames at a time as the receiver allows
+	int idx = 1;
+	while (numBytes > 0) {
+		// get a flow control (FC) frame
+		int blockSize, separationTime;
+		if (!receiveFlowControl(blockSize, separationTime, timeout)) {
 			return 0;
 		}
-		receiveFrame(&rxmsg, nullptr, 0, timeout);
-		int flowStatus = rxmsg.data8[0] & 0xf;
-		// if something is not ok
-		if (flowStatus != CAN_FLOW_STATUS_OK) {
-			// if the receiver is not ready yet and asks to wait for the next FC frame (give it 3 attempts)
-			if (flowStatus == CAN_FLOW_STATUS_WAIT_MORE && numFcReceived < 3) {
-				continue;
+
+		// zero block size means the rest of the packet without waiting for flow control
+		for (int numFramesInBlock = 0; numBytes > 0 && (blockSize == 0 || numFramesInBlock < blockSize); numFramesInBlock++) {
+			if (numFramesInBlock > 0) {
+				waitSeparationTime(separationTime);
 			}
-#ifdef SERIAL_CAN_DEBUG
-			efiPrintf("*** ERROR: CAN Flow Control mode not supported");
-#endif /* SERIAL_CAN_DEBUG */
-			//warning(ObdCode::CUSTOM_ERR_CAN_COMMUNICATION, "CAN Flow Control mode not supported");
-			return 0;
-		}
-		int blockSize = rxmsg.data8[1];
-		int minSeparationTime = rxmsg.data8[2];
-		if (blockSize != 0 || minSeparationTime != 0) {
-			// todo: process other Flow Control fields (see ISO 15765-2)
-#ifdef SERIAL_CAN_DEBUG
-			efiPrintf("*** ERROR: CAN Flow Control fields not supported");
-#endif /* SERIAL_CAN_DEBUG */
-			//warning(ObdCode::CUSTOM_ERR_CAN_COMMUNICATION, "CAN Flow Control fields not supported");
-		}
-		break;
-	}
-#endif /* EFI_UNIT_TEST */
 
-	// send the rest of the data
-	int idx = 1;
-	while (numBytes > 0) {
-		int len = minI(numBytes, 7);
-		// send the consecutive frames
-		header.frameType = ISO_TP_FRAME_CONSECUTIVE;
-		header.index = ((idx++) & 0x0f);
-		header.numBytes = len;
-		numSent = sendFrame(header, txbuf + offset, len, timeout);
-		if (numSent < 1)
-			break;
-		totalNumSent += numSent;
-		offset += numSent;
-		numBytes -= numSent;
+			int len = minI(numBytes, 7);
+			// send the consecutive frames
+			header.frameType = ISO_TP_FRAME_CONSECUTIVE;
+			header.index = ((idx++) & 0x0f);
+			header.numBytes = len;
+			numSent = sendFrame(header, txbuf + offset, len, timeout);
+			if (numSent < 1)
+				return totalNumSent;
+			totalNumSent += numSent;
+			offset += numSent;
+			numBytes -= numSent;
+		}
 	}
 	return totalNumSent;
 }
@@ -26,7 +26,35 @@
 
 // most efficient sizes are 6 + x * 7 that way whole buffer is transmitted as (x+1) full packets
 #define CAN_FIFO_BUF_SIZE 76
-#define CAN_FIFO_FRAME_SIZE 8
+
+/**
+ * Whole TS packet (size, response code, up to BLOCKING_FACTOR of data and CRC) is sent as one ISO-TP message,
+ * so that there is just one flow control round trip per packet
+ */
+#ifndef CAN_TX_FIFO_BUF_SIZE
+#define CAN_TX_FIFO_BUF_SIZE (BLOCKING_FACTOR + 7)
+#endif
+
+// 12 bit length of 'first' frame
+#define ISO_TP_MAX_MESSAGE_SIZE 4095
+static_assert(CAN_TX_FIFO_BUF_SIZE <= ISO_TP_MAX_MESSAGE_SIZE);
+
+// number of incoming frames CanTsListener is able to queue until TS thread gets to them
+#ifndef CAN_FIFO_FRAME_SIZE
+#define CAN_FIFO_FRAME_SIZE 32
+#endif
+
+/**
+ * Flow control we ask for while receiving multi-frame packet: number of consecutive frames
+ * between flow control frames and separation time between consecutive frames, see getIsoTpSeparationTimeUs()
+ * Block size should not be above CAN_FIFO_FRAME_SIZE, zero means the whole packet at once.
+ */
+#ifndef CAN_ISO_TP_RX_BLOCK_SIZE
+#define CAN_ISO_TP_RX_BLOCK_SIZE CAN_FIFO_FRAME_SIZE
+#endif
+#ifndef CAN_ISO_TP_RX_SEPARATION_TIME
+#define CAN_ISO_TP_RX_SEPARATION_TIME 0
+#endif
 
 #define CAN_FLOW_STATUS_OK 0
 #define CAN_FLOW_STATUS_WAIT_MORE 1
@@ -61,10 +89,17 @@ public:
 	virtual can_msg_t receive(canmbx_t mailbox, CANRxFrame *crfp, can_sysinterval_t timeout) = 0;
 };
 
+/**
+ * @return ISO-TP STmin in microseconds: 0x00-0x7F milliseconds, 0xF1-0xF9 100-900 microseconds,
+ * reserved values are to be treated as the max
+ */
+int getIsoTpSeparationTimeUs(int separationTime);
+
 class CanStreamerState {
 public:
+	// only holds what is left of one frame
 	fifo_buffer<uint8_t, CAN_FIFO_BUF_SIZE> rxFifoBuf;
-	fifo_buffer<uint8_t, CAN_FIFO_BUF_SIZE> txFifoBuf;
+	fifo_buffer<uint8_t, CAN_TX_FIFO_BUF_SIZE> txFifoBuf;
 
 #if defined(TS_CAN_DEVICE_SHORT_PACKETS_IN_ONE_FRAME)
 	// used to restore the original packet with CRC
@@ -74,6 +109,12 @@ public:
 	// used for multi-frame ISO-TP packets
 	int waitingForNumBytes = 0;
 	int waitingForFrameIndex = 0;
+	// consecutive frames until we owe the sender next flow control frame
+	int framesTillFlowControl = 0;
+
+	// see CAN_ISO_TP_RX_BLOCK_SIZE
+	int rxBlockSize = CAN_ISO_TP_RX_BLOCK_SIZE;
+	int rxSeparationTime = CAN_ISO_TP_RX_SEPARATION_TIME;
 
 	ICanStreamer *streamer;
 	
@@ -83,6 +124,8 @@ public:
 	int sendFrame(const IsoTpFrameHeader & header, const uint8_t *data, int num, can_sysinterval_t timeout);
 	int receiveFrame(CANRxFrame *rxmsg, uint8_t *buf, int num, can_sysinterval_t timeout);
 	int getDataFromFifo(uint8_t *rxbuf, size_t &numBytes);
+	void sendFlowControl(can_sysinterval_t timeout);
+	bool receiveFlowControl(int &blockSize, int &separationTime, can_sysinterval_t timeout);
 	// returns the number of bytes sent
 	int sendDataTimeout(const uint8_t *txbuf, int numBytes, can_sysinterval_t timeout);
 
@@ -80,8 +80,9 @@ void DisableToothLogger() {
 
 #else // not EFI_UNIT_TEST
 
-static constexpr size_t BUFFER_COUNT = BIG_BUFFER_SIZE / sizeof(CompositeBuffer);
-static_assert(BUFFER_COUNT >= 2);
+// Not the whole big buffer: leave room for perf trace to run at the same time
+static constexpr size_t BUFFER_COUNT = 4;
+static_assert(BUFFER_COUNT * sizeof(CompositeBuffer) <= BIG_BUFFER_SIZE);
 
 static CompositeBuffer* buffers = nullptr;
 static chibios_rt::Mailbox<CompositeBuffer*, BUFFER_COUNT> freeBuffers CCM_OPTIONAL;
@@ -100,7 +101,7 @@ static BigBufferHandle bufferHandle;
 void EnableToothLogger() {
 	chibios_rt::CriticalSectionLocker csl;
 
-	bufferHandle = getBigBuffer(BigBufferUser::ToothLogger);
+	bufferHandle = getBigBuffer(BigBufferUser::ToothLogger, BUFFER_COUNT * sizeof(CompositeBuffer));
 	if (!bufferHandle) {
 		return;
 	}
@@ -0,0 +1,129 @@
+/**
+ * @file ts_config_staging.cpp
+ */
+
+#include "pch.h"
+
+#include "ts_config_staging.h"
+#include "tunerstudio.h"
+#include "ts_page_crc.h"
+
+bool ConfigWriteStaging::stage(uint16_t offset, uint16_t count, const void *content) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (m_writeCount >= efi::size(m_writes) || m_dataSize + count > sizeof(m_data)) {
+		return false;
+	}
+
+	memcpy(m_data + m_dataSize, content, count);
+	m_writes[m_writeCount] = { offset, count };
+	m_writeCount++;
+	m_dataSize += count;
+
+	m_lastStage.reset();
+
+	return true;
+}
+
+int ConfigWriteStaging::commit() {
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (m_writeCount == 0) {
+		return publishCounter;
+	}
+
+	m_isCommitted = true;
+	return publishCounter + 1;
+}
+
+bool ConfigWriteStaging::publish(uint8_t *target) {
+	// One lock for the whole batch: nothing can observe some of the writes but not the others
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (m_writeCount == 0) {
+		return false;
+	}
+
+	// Writes are applied in order they came from TS so later write of the same byte wins
+	size_t dataOffset = 0;
+	for (size_t i = 0; i < m_writeCount; i++) {
+		const StagedWrite& write = m_writes[i];
+		memcpy(target + write.offset, m_data + dataOffset, write.count);
+		invalidateConfigPageCrc(write.offset, write.count);
+		dataOffset += write.count;
+	}
+
+	m_writeCount = 0;
+	m_dataSize = 0;
+	m_isCommitted = false;
+	publishCounter++;
+
+	return true;
+}
+
+bool ConfigWriteStaging::isReadyToPublish() const {
+	return m_writeCount != 0 && (m_isCommitted || m_lastStage.hasElapsedMs(TS_CONFIG_STAGING_QUIET_MS));
+}
+
+bool ConfigWriteStaging::hasPending() const {
+	return m_writeCount != 0;
+}
+
+void ConfigWriteStaging::discard() {
+	chibios_rt::CriticalSectionLocker csl;
+
+	m_writeCount = 0;
+	m_dataSize = 0;
+	m_isCommitted = false;
+}
+
+void ConfigWriteStaging::reset() {
+	discard();
+	publishCounter = 0;
+	m_lastStage.init();
+}
+
+static ConfigWriteStaging configStaging;
+
+bool stageConfigWrite(uint16_t offset, uint16_t count, const void *content) {
+	if (configStaging.stage(offset, count, content)) {
+		return true;
+	}
+
+	// Publishing what we have could leave a table half written, so drop the batch instead:
+	// live configuration stays consistent and TS finds out about the mismatch from page CRC
+	configStaging.discard();
+	return false;
+}
+
+void commitStagedConfigWrites() {
+	int version = configStaging.commit();
+
+#if ! EFI_UNIT_TEST
+	// Fast callback publishes at its safe point, unit tests invoke publishStagedConfigWrites() themselves
+	Timer waiting;
+	waiting.reset();
+	while (configStaging.publishCounter < version && !waiting.hasElapsedMs(TS_CONFIG_STAGING_COMMIT_TIMEOUT_MS)) {
+		chThdSleepMilliseconds(1);
+	}
+#else
+	UNUSED(version);
+#endif // EFI_UNIT_TEST
+}
+
+void publishStagedConfigWrites() {
+	if (!configStaging.isReadyToPublish()) {
+		return;
+	}
+
+	if (configStaging.publish(getWorkingPageAddr())) {
+		// Force any board configuration options that humans shouldn't be able to change
+		setBoardConfigOverrides();
+	}
+}
+
+#if EFI_UNIT_TEST
+void resetConfigStagingForUnitTests() {
+	configStaging.reset();
+}
+#endif // EFI_UNIT_TEST
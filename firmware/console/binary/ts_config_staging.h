@@ -0,0 +1,90 @@
+/**
+ * @file ts_config_staging.h
+ *
+ * TunerStudio writes table in a number of chunks. Writing chunks directly into live
+ * configuration lets trigger and fast callback observe half written table, so
+ * chunks are collected here as one batch. The batch is copied to live configuration
+ * in a single critical section and only at fast callback safe point, so readers see
+ * either none or all of it.
+ */
+
+#pragma once
+
+#include <rusefi/timer.h>
+
+#ifndef TS_CONFIG_STAGING_SIZE
+#define TS_CONFIG_STAGING_SIZE (2 * BLOCKING_FACTOR)
+#endif
+
+#ifndef TS_CONFIG_STAGING_WRITES
+#define TS_CONFIG_STAGING_WRITES 32
+#endif
+
+// Writes which are this old are published even if TS did not follow them with any other command
+#define TS_CONFIG_STAGING_QUIET_MS 50
+
+// How long TS thread waits for fast callback to publish committed batch
+#define TS_CONFIG_STAGING_COMMIT_TIMEOUT_MS 100
+
+class ConfigWriteStaging {
+public:
+	/**
+	 * @return false if there is no room left in the batch
+	 */
+	bool stage(uint16_t offset, uint16_t count, const void *content);
+	/**
+	 * TS is done with current batch: publish it at next safe point without waiting for quiet
+	 * @return value of publishCounter once the batch is published
+	 */
+	int commit();
+	/**
+	 * Apply the whole batch to target in one critical section
+	 * @return true if anything was applied
+	 */
+	bool publish(uint8_t *target);
+	bool isReadyToPublish() const;
+	bool hasPending() const;
+	/**
+	 * Drop current batch without applying any of it
+	 */
+	void discard();
+	void reset();
+
+	// incremented once per published batch
+	int publishCounter = 0;
+
+private:
+	struct StagedWrite {
+		uint16_t offset;
+		uint16_t count;
+	};
+
+	StagedWrite m_writes[TS_CONFIG_STAGING_WRITES];
+	size_t m_writeCount = 0;
+
+	uint8_t m_data[TS_CONFIG_STAGING_SIZE];
+	size_t m_dataSize = 0;
+
+	bool m_isCommitted = false;
+	Timer m_lastStage;
+};
+
+/**
+ * Stage TunerStudio write to configuration page. If the batch has no room left it is dropped
+ * as a whole, live configuration is not touched.
+ * @return false if the write did not fit, TS should be sent an error
+ */
+bool stageConfigWrite(uint16_t offset, uint16_t count, const void *content);
+/**
+ * Invoked by TS thread once TS expects to see its writes: waits for fast callback to publish staged batch
+ */
+void commitStagedConfigWrites();
+/**
+ * Invoked at safe point of fast callback: publish committed batch, or any batch once TunerStudio
+ * stopped writing for a moment. This invokes setBoardConfigOverrides() once per publish
+ */
+void publishStagedConfigWrites();
+
+#if EFI_UNIT_TEST
+void resetConfigStagingForUnitTests();
+#endif // EFI_UNIT_TEST
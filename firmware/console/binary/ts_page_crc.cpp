@@ -0,0 +1,144 @@
+/**
+ * @file ts_page_crc.cpp
+ */
+
+#include "pch.h"
+
+#include "ts_page_crc.h"
+#include "tunerstudio.h"
+#include "fast_crc32.h"
+
+PageCrcCache::PageCrcCache(size_t pageSize)
+	: m_pageSize(pageSize)
+	, m_blockCount((pageSize + TS_PAGE_CRC_BLOCK_SIZE - 1) / TS_PAGE_CRC_BLOCK_SIZE)
+	, m_blockZerosOperator(crc32ZerosOperator(TS_PAGE_CRC_BLOCK_SIZE))
+{
+	criticalAssertVoid(m_blockCount <= TS_PAGE_CRC_MAX_BLOCKS, "page CRC cache too small");
+}
+
+size_t PageCrcCache::getBlockSize(size_t index) const {
+	return minI(TS_PAGE_CRC_BLOCK_SIZE, m_pageSize - index * TS_PAGE_CRC_BLOCK_SIZE);
+}
+
+uint32_t PageCrcCache::computeBlockCrc(const uint8_t *page, size_t index) {
+	uint32_t writeCounter;
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		writeCounter = m_writeCounter;
+	}
+
+	uint32_t crc = fastCrc32(page + index * TS_PAGE_CRC_BLOCK_SIZE, getBlockSize(index));
+	computeCounter++;
+
+	chibios_rt::CriticalSectionLocker csl;
+	// Block could have been half way written while we were reading it
+	if (writeCounter == m_writeCounter) {
+		m_blockCrc[index] = crc;
+		m_isValid[index] = true;
+	}
+
+	return crc;
+}
+
+uint32_t PageCrcCache::getBlockCrc(const uint8_t *page, size_t index) {
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		if (m_isValid[index]) {
+			return m_blockCrc[index];
+		}
+	}
+
+	return computeBlockCrc(page, index);
+}
+
+uint32_t PageCrcCache::get(const uint8_t *page, size_t offset, size_t count) {
+	uint32_t crc = 0;
+	size_t end = offset + count;
+
+	while (offset < end) {
+		size_t index = offset / TS_PAGE_CRC_BLOCK_SIZE;
+		size_t blockStart = index * TS_PAGE_CRC_BLOCK_SIZE;
+		size_t blockSize = getBlockSize(index);
+
+		if (offset == blockStart && end >= blockStart + blockSize) {
+			// Whole block is covered, append its CRC
+			uint32_t zerosOperator = blockSize == TS_PAGE_CRC_BLOCK_SIZE ? m_blockZerosOperator : crc32ZerosOperator(blockSize);
+			crc = crc32Combine(crc, getBlockCrc(page, index), zerosOperator);
+			offset += blockSize;
+		} else {
+			// Partial block at either end of the range
+			size_t size = minI(end, blockStart + blockSize) - offset;
+			crc = fastCrc32Inc(page + offset, crc, size);
+			offset += size;
+		}
+	}
+
+	return crc;
+}
+
+void PageCrcCache::invalidate(size_t offset, size_t count) {
+	if (count == 0) {
+		return;
+	}
+
+	size_t first = offset / TS_PAGE_CRC_BLOCK_SIZE;
+	size_t last = (offset + count - 1) / TS_PAGE_CRC_BLOCK_SIZE;
+
+	chibios_rt::CriticalSectionLocker csl;
+	for (size_t i = first; (i <= last) && (i < m_blockCount); i++) {
+		m_isValid[i] = false;
+	}
+	m_writeCounter++;
+}
+
+void PageCrcCache::invalidateAll() {
+	invalidate(0, m_pageSize);
+}
+
+void PageCrcCache::update(const uint8_t *page, size_t maxBlocks) {
+	for (size_t i = 0; (i < m_blockCount) && (maxBlocks > 0); i++) {
+		if (!m_isValid[i]) {
+			computeBlockCrc(page, i);
+			maxBlocks--;
+		}
+	}
+
+	// Catch writes which did not invalidate the cache
+	computeBlockCrc(page, m_refreshIndex);
+	m_refreshIndex = (m_refreshIndex + 1) % m_blockCount;
+}
+
+#if EFI_TUNER_STUDIO
+
+static PageCrcCache configPageCrc(TOTAL_CONFIG_SIZE);
+
+uint32_t getConfigPageCrc(size_t offset, size_t count) {
+	return configPageCrc.get(getWorkingPageAddr(), offset, count);
+}
+
+void invalidateConfigPageCrc(size_t offset, size_t count) {
+	configPageCrc.invalidate(offset, count);
+}
+
+void updateConfigPageCrc() {
+	configPageCrc.update(getWorkingPageAddr(), TS_PAGE_CRC_BLOCKS_PER_UPDATE);
+}
+
+#if EFI_UNIT_TEST
+int getConfigPageCrcComputeCounterForUnitTests() {
+	return configPageCrc.computeCounter;
+}
+#endif // EFI_UNIT_TEST
+
+#else
+
+void invalidateConfigPageCrc(size_t, size_t) {
+}
+
+#endif // EFI_TUNER_STUDIO
+
+void invalidateConfigValueByNameCrc() {
+	// see value_lookup_generated.cpp
+	invalidateConfigFieldCrc(*engineConfiguration);
+	invalidateConfigFieldCrc(config->tcu_shiftTime);
+}
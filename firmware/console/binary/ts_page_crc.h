@@ -0,0 +1,85 @@
+/**
+ * @file ts_page_crc.h
+ *
+ * TunerStudio asks for CRC of whole configuration page on each connect and after each burn.
+ * Page is split into blocks with CRC of each block kept until a write touches that block, CRC of
+ * any range is then put together from cached blocks without reading the page again.
+ *
+ * Writes by TunerStudio invalidate blocks they touch, so do console and Lua writes and configuration
+ * resets. Burn does not change the page and keeps the cache. Writes which went around all of these are
+ * caught by background refresh which re-reads one block at a time.
+ */
+
+#pragma once
+
+#ifndef TS_PAGE_CRC_BLOCK_SIZE
+#define TS_PAGE_CRC_BLOCK_SIZE 256
+#endif
+
+// Blocks missing from cache which updateConfigPageCrc() computes per invocation
+#ifndef TS_PAGE_CRC_BLOCKS_PER_UPDATE
+#define TS_PAGE_CRC_BLOCKS_PER_UPDATE 4
+#endif
+
+#define TS_PAGE_CRC_MAX_BLOCKS ((TOTAL_CONFIG_SIZE + TS_PAGE_CRC_BLOCK_SIZE - 1) / TS_PAGE_CRC_BLOCK_SIZE)
+
+class PageCrcCache {
+public:
+	explicit PageCrcCache(size_t pageSize);
+
+	/**
+	 * Same as crc32() of given range of the page
+	 */
+	uint32_t get(const uint8_t *page, size_t offset, size_t count);
+	void invalidate(size_t offset, size_t count);
+	void invalidateAll();
+	/**
+	 * Compute up to maxBlocks blocks missing from cache, then re-check the next block in round robin
+	 */
+	void update(const uint8_t *page, size_t maxBlocks);
+
+	// number of blocks actually read
+	int computeCounter = 0;
+
+private:
+	size_t getBlockSize(size_t index) const;
+	uint32_t getBlockCrc(const uint8_t *page, size_t index);
+	uint32_t computeBlockCrc(const uint8_t *page, size_t index);
+
+	const size_t m_pageSize;
+	const size_t m_blockCount;
+	// crc32ZerosOperator() of a whole block
+	const uint32_t m_blockZerosOperator;
+
+	uint32_t m_blockCrc[TS_PAGE_CRC_MAX_BLOCKS];
+	bool m_isValid[TS_PAGE_CRC_MAX_BLOCKS] = {};
+
+	// bumped on each invalidation so that block read while being written is not cached
+	uint32_t m_writeCounter = 0;
+	size_t m_refreshIndex = 0;
+};
+
+/**
+ * CRC of a range of working configuration page
+ */
+uint32_t getConfigPageCrc(size_t offset, size_t count);
+/**
+ * Invoked after anything writes to working configuration page
+ */
+void invalidateConfigPageCrc(size_t offset, size_t count);
+/**
+ * Same for one field of working configuration, field has to be addressable, for bit fields use the whole structure
+ */
+#define invalidateConfigFieldCrc(field) invalidateConfigPageCrc(reinterpret_cast<const uint8_t*>(&(field)) - reinterpret_cast<const uint8_t*>(config), sizeof(field))
+/**
+ * setConfigValueByName() does not tell which field it has written, invalidates everything it could write to
+ */
+void invalidateConfigValueByNameCrc();
+/**
+ * Invoked from slow callback so that cache is warm by the time TunerStudio connects
+ */
+void updateConfigPageCrc();
+
+#if EFI_UNIT_TEST
+int getConfigPageCrcComputeCounterForUnitTests();
+#endif // EFI_UNIT_TEST
@@ -64,6 +64,9 @@
 
 #include "tunerstudio.h"
 #include "tunerstudio_impl.h"
+#include "ts_config_staging.h"
+#include "ts_page_crc.h"
+#include "fast_crc32.h"
 
 #include "main_trigger_callback.h"
 #include "flash_main.h"
@@ -225,11 +228,12 @@ void TunerStudio::handleWriteChunkCommand(TsChannelBase* tsChannel, uint16_t pag
 
 		// Skip the write if a preset was just loaded - we don't want to overwrite it
 		if (!wasPresetJustApplied()) {
-			uint8_t * addr = (uint8_t *) (getWorkingPageAddr() + offset);
-			memcpy(addr, content, count);
+			// Not applied to live configuration right away, see ts_config_staging.h
+			if (!stageConfigWrite(offset, count, content)) {
+				sendErrorCode(tsChannel, TS_RESPONSE_OVERRUN, "ERROR: WR staging full");
+				return;
+			}
 		}
-		// Force any board configuration options that humans shouldn't be able to change
-		setBoardConfigOverrides();
 
 		sendOkResponse(tsChannel);
 	} else {
@@ -260,11 +264,10 @@ void TunerStudio::handleCrc32Check(TsChannelBase *tsChannel, uint16_t offset, ui
 	 * Support settings pages!
 	 */
 	memset(engineConfiguration->highSpeedOffsets, 0x00, sizeof(engineConfiguration->highSpeedOffsets));
+	invalidateConfigPageCrc((uint8_t*)engineConfiguration->highSpeedOffsets - getWorkingPageAddr(), sizeof(engineConfiguration->highSpeedOffsets));
 #endif // EFI_TS_SCATTER
 
-	const uint8_t* start = getWorkingPageAddr() + offset;
-
-	uint32_t crc = SWAP_UINT32(crc32(start, count));
+	uint32_t crc = SWAP_UINT32(getConfigPageCrc(offset, count));
 	tsChannel->sendResponse(TS_CRC, (const uint8_t *) &crc, 4);
 	efiPrintf("TS <- Get CRC offset %d count %d result %08x", offset, count, (unsigned int)crc);
 }
@@ -303,7 +306,7 @@ void TunerStudio::handleScatteredReadCommand(TsChannelBase* tsChannel) {
 		// write each data point and CRC incrementally
 		copyRange(dataBuffer, getLiveDataFragments(), offset, size);
 		tsChannel->write(dataBuffer, size, false);
-		crc = crc32inc((void*)dataBuffer, crc, size);
+		crc = fastCrc32Inc(dataBuffer, crc, size);
 	}
 #if EFI_SIMULATOR
 //	printf("CRC %x\n", crc);
@@ -327,15 +330,13 @@ void TunerStudio::handlePageReadCommand(TsChannelBase* tsChannel, uint16_t page,
 			return;
 		}
 
-		uint8_t* addr;
+		// staged writes have just been published and nobody else writes the page, safe to send it as is
+		TsFragment fragment = { getWorkingPageAddr() + offset, count };
 		if (isLockedFromUser()) {
 			// to have rusEFI console happy just send all zeros within a valid packet
-			addr = (uint8_t*)&tsChannel->scratchBuffer + TS_PACKET_HEADER_SIZE;
-			memset(addr, 0, count);
-		} else {
-			addr = getWorkingPageAddr() + offset;
+			fragment.data = nullptr;
 		}
-		tsChannel->sendResponse(TS_CRC, addr, count);
+		tsChannel->writeCrcPacketFragments(TS_RESPONSE_OK, &fragment, 1);
 #if EFI_TUNER_STUDIO_VERBOSE
 //		efiPrintf("Sending %d done", count);
 #endif
@@ -590,7 +591,7 @@ static int tsProcessOne(TsChannelBase* tsChannel) {
 
 	expectedCrc = SWAP_UINT32(expectedCrc);
 
-	uint32_t actualCrc = crc32(tsChannel->scratchBuffer, incomingPacketSize);
+	uint32_t actualCrc = fastCrc32(tsChannel->scratchBuffer, incomingPacketSize);
 	if (actualCrc != expectedCrc) {
 		/* send error only if previously we were in sync */
 		if (tsChannel->in_sync) {
@@ -708,6 +709,12 @@ int TunerStudio::handleCrcCommand(TsChannelBase* tsChannel, char *data, int inco
 		count = data16[1];
 	}
 
+	// Anything but another write or live data poll means TS is done writing and expects to see its changes
+	if (command != TS_CHUNK_WRITE_COMMAND && command != TS_SINGLE_WRITE_COMMAND
+			&& command != TS_OUTPUT_COMMAND && command != TS_OUTPUT_ALL_COMMAND) {
+		commitStagedConfigWrites();
+	}
+
 	switch(command)
 	{
 	case TS_OUTPUT_COMMAND:
@@ -6,6 +6,8 @@ TUNERSTUDIO_SRC_CPP = $(PROJECT_DIR)/console/binary/tunerstudio_io.cpp \
 	$(PROJECT_DIR)/console/binary/ts_can_channel.cpp \
 	$(PROJECT_DIR)/console/binary/serial_can.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio.cpp \
+	$(PROJECT_DIR)/console/binary/ts_config_staging.cpp \
+	$(PROJECT_DIR)/console/binary/ts_page_crc.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio_commands.cpp \
 	$(PROJECT_DIR)/console/binary/bluetooth.cpp \
 	$(PROJECT_DIR)/console/binary/signature.cpp \
@@ -52,15 +52,31 @@ void TunerStudio::cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, u
 
 	tsState.outputChannelsCommandCounter++;
 	updateTunerStudioState();
-	tsChannel->assertPacketSize(count, false);
 	// this method is invoked too often to print any debug information
-	uint8_t * scratchBuffer = (uint8_t *)tsChannel->scratchBuffer;
+
 	/**
-	 * collect data from all models
+	 * send data from all models right from where it lives, no need to collect it into scratchBuffer first
 	 */
-	copyRange(scratchBuffer + 3, getLiveDataFragments(), offset, count);
+	uint32_t crc = tsChannel->writePacketHeader(TS_RESPONSE_OK, count);
+	size_t remaining = count;
+
+	FragmentList fragments = getLiveDataFragments();
+	for (size_t i = 0; i < fragments.count && remaining > 0; i++) {
+		const FragmentEntry& fragment = fragments.fragments[i];
+		if (offset >= fragment.size) {
+			offset -= fragment.size;
+			continue;
+		}
+
+		size_t size = minI(fragment.size - offset, remaining);
+		crc = tsChannel->writeLiveDataFragment(crc, fragment.data ? fragment.data + offset : nullptr, size);
+		remaining -= size;
+		offset = 0;
+	}
 
-	tsChannel->crcAndWriteBuffer(TS_RESPONSE_OK, count);
+	// requested range is checked against TS_TOTAL_OUTPUT_SIZE, still packet has to be as long as header says
+	crc = tsChannel->writeFragment(crc, nullptr, remaining);
+	tsChannel->writePacketFooter(crc);
 }
 
 #endif // EFI_TUNER_STUDIO
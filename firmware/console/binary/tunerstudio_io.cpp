@@ -8,6 +8,7 @@
 #include "pch.h"
 
 #include "tunerstudio_io.h"
+#include "fast_crc32.h"
 
 #if EFI_SIMULATOR
 #include "rusEfiFunctionalTest.h"
@@ -47,7 +48,7 @@ void TsChannelBase::crcAndWriteBuffer(uint8_t responseCode, size_t size) {
 	scratchBuffer[2] = responseCode;
 
 	// CRC is computed on the responseCode and payload but not length
-	uint32_t crc = crc32(&scratchBuffer[2], size + 1); // command part of CRC
+	uint32_t crc = fastCrc32(&scratchBuffer[2], size + 1); // command part of CRC
 
 	// Place the CRC at the end
 	crc = SWAP_UINT32(crc);
@@ -66,26 +67,74 @@ uint32_t TsChannelBase::writePacketHeader(const uint8_t responseCode, const size
 	write(headerBuffer, sizeof(headerBuffer), /*isEndOfPacket*/false);
 
 	 // Command part of CRC
-	return crc32((void*)(headerBuffer + 2), 1);
+	return fastCrc32(headerBuffer + 2, 1);
 }
 
-void TsChannelBase::writeCrcPacketLarge(const uint8_t responseCode, const uint8_t* buf, const size_t size) {
+// zeros and live data go to write() in pieces of this size
+#define TS_FRAGMENT_PIECE_SIZE 64
+
+uint32_t TsChannelBase::writeFragment(uint32_t crc, const uint8_t* data, size_t size) {
+	if (data) {
+		crc = fastCrc32Inc(data, crc, size);
+		write(data, size, /*isEndOfPacket*/false);
+		return crc;
+	}
+
+	static const uint8_t zeros[TS_FRAGMENT_PIECE_SIZE] = { 0 };
+	while (size > 0) {
+		size_t pieceSize = minI(size, sizeof(zeros));
+		crc = fastCrc32Inc(zeros, crc, pieceSize);
+		write(zeros, pieceSize, /*isEndOfPacket*/false);
+		size -= pieceSize;
+	}
+	return crc;
+}
+
+uint32_t TsChannelBase::writeLiveDataFragment(uint32_t crc, const uint8_t* data, size_t size) {
+	if (!data) {
+		return writeFragment(crc, data, size);
+	}
+
+	uint8_t piece[TS_FRAGMENT_PIECE_SIZE];
+	while (size > 0) {
+		size_t pieceSize = minI(size, sizeof(piece));
+		memcpy(piece, data, pieceSize);
+		crc = writeFragment(crc, piece, pieceSize);
+		data += pieceSize;
+		size -= pieceSize;
+	}
+	return crc;
+}
+
+void TsChannelBase::writePacketFooter(uint32_t crc) {
 	uint8_t crcBuffer[4];
+	*(uint32_t*)crcBuffer = SWAP_UINT32(crc);
+
+	write(crcBuffer, sizeof(crcBuffer), /*isEndOfPacket*/true);
+	flush();
+}
+
+void TsChannelBase::writeCrcPacketFragments(uint8_t responseCode, const TsFragment* fragments, size_t count) {
+	size_t size = 0;
+	for (size_t i = 0; i < count; i++) {
+		size += fragments[i].size;
+	}
 
 	// Command part of CRC
 	uint32_t crc = writePacketHeader(responseCode, size);
-	// Data part of CRC
-	crc = crc32inc((void*)buf, crc, size);
-	*(uint32_t*)crcBuffer = SWAP_UINT32(crc);
 
-	// If data, write that
-	if (size) {
-		write(buf, size, /*isEndOfPacket*/false);
+	for (size_t i = 0; i < count; i++) {
+		if (fragments[i].size) {
+			crc = writeFragment(crc, fragments[i].data, fragments[i].size);
+		}
 	}
 
-	// Lastly the CRC footer
-	write(crcBuffer, sizeof(crcBuffer), /*isEndOfPacket*/true);
-	flush();
+	writePacketFooter(crc);
+}
+
+void TsChannelBase::writeCrcPacketLarge(const uint8_t responseCode, const uint8_t* buf, const size_t size) {
+	TsFragment fragment = { buf, size };
+	writeCrcPacketFragments(responseCode, &fragment, 1);
 }
 
 TsChannelBase::TsChannelBase(const char *p_name) {
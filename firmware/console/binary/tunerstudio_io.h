@@ -26,6 +26,15 @@
 #define TS_PACKET_HEADER_SIZE	3
 #define TS_PACKET_TAIL_SIZE		4
 
+/**
+ * Piece of response payload, see TsChannelBase::writeCrcPacketFragments
+ */
+struct TsFragment {
+	// nullptr is sent as zeros
+	const uint8_t* data;
+	size_t size;
+};
+
 class TsChannelBase {
 public:
 	TsChannelBase(const char *name);
@@ -62,6 +71,18 @@ public:
 	void crcAndWriteBuffer(const uint8_t responseCode, const size_t size);
 	void copyAndWriteSmallCrcPacket(uint8_t responseCode, const uint8_t* buf, size_t size);
 
+	/**
+	 * Scatter-gather response: header, payload fragments and CRC footer. Fragments go to write() right from
+	 * where they live with CRC computed along the way, there is no copy into scratchBuffer and no limit on size.
+	 * Fragment data must not change while it is being sent, see writeLiveDataFragment() for data which does.
+	 */
+	void writeCrcPacketFragments(uint8_t responseCode, const TsFragment* fragments, size_t count);
+	// building blocks of writeCrcPacketFragments() for responses which are not a list, start with writePacketHeader()
+	uint32_t writeFragment(uint32_t crc, const uint8_t* data, size_t size);
+	// stages small pieces on stack so that CRC matches what was sent even if data is changed by other threads
+	uint32_t writeLiveDataFragment(uint32_t crc, const uint8_t* data, size_t size);
+	void writePacketFooter(uint32_t crc);
+
 	// Write a response code with no data
 	void writeCrcResponse(uint8_t responseCode) {
 		writeCrcPacketLarge(responseCode, nullptr, 0);
@@ -27,6 +27,7 @@
 #include "eficonsole.h"
 #include "console_io.h"
 #include "mpu_util.h"
+#include "thread_profiler.h"
 
 #if defined(STM32F4) || defined(STM32F7) || defined(STM32H7)
 static void printUid() {
@@ -261,6 +262,15 @@ void initializeConsole() {
 #endif
 
 	addConsoleAction("threadsinfo", cmd_threads);
+#if EFI_THREAD_PROFILER
+	addConsoleAction("cpuload", printThreadProfiler);
+#endif // EFI_THREAD_PROFILER
+	addConsoleAction("bigbuffer", printBigBufferUsage);
+#if EFI_BINARY_LOGGING
+	addConsoleActionI("binarylog", [](int value) {
+		setBinaryLogging(value);
+	});
+#endif // EFI_BINARY_LOGGING
 
 #if HAL_USE_WDG
 	addConsoleActionI("set_watchdog_timeout", startWatchdog);
@@ -38,6 +38,8 @@
 #include "mmc_card.h"
 #include "console_io.h"
 #include "malfunction_central.h"
+#include "thread_profiler.h"
+#include "periodic_executor.h"
 #include "speed_density.h"
 
 #include "tunerstudio.h"
@@ -252,12 +254,11 @@ static bool isTriggerErrorNow() {
 
 extern bool consoleByteArrived;
 
-class CommunicationBlinkingTask : public PeriodicTimerController {
-
-	int getPeriodMs() override {
-		return counter % 2 == 0 ? onTimeMs : offTimeMs;
-	}
+class CommunicationBlinkingTask : public PeriodicJob {
+public:
+	CommunicationBlinkingTask() : PeriodicJob("CommBlink", PeriodicLane::Low, 10) { }
 
+private:
 	void setAllLeds(int value) {
 		// make sure we do not turn the critical LED off if already have
 		// critical error by now
@@ -266,7 +267,13 @@ class CommunicationBlinkingTask : public PeriodicTimerController {
 		}
 	}
 
-	void PeriodicTask() override {
+	void PeriodicTask(efitick_t) override {
+		blink();
+
+		setPeriod(counter % 2 == 0 ? onTimeMs : offTimeMs);
+	}
+
+	void blink() {
 		counter++;
 
 		if (counter == 1) {
@@ -323,7 +330,6 @@ class CommunicationBlinkingTask : public PeriodicTimerController {
 		}
 	}
 
-private:
 	int counter = 0;
 	int onTimeMs = 100;
 	int offTimeMs = 100;
@@ -679,6 +685,10 @@ void updateTunerStudioState() {
 	executorStatistics();
 #endif /* EFI_PROD_CODE */
 
+#if EFI_THREAD_PROFILER
+	updateThreadProfiler();
+#endif /* EFI_THREAD_PROFILER */
+
 	// header
 	tsOutputChannels->tsConfigVersion = TS_FILE_VERSION;
 	static_assert(offsetof (TunerStudioOutputChannels, tsConfigVersion) == TS_FILE_VERSION_OFFSET);
@@ -125,7 +125,7 @@ void initAlternatorCtrl() {
 
 	startSimplePwm(&alternatorControl,
 				"Alternator control",
-				&engine->scheduler,
+				getLowPriorityScheduler(),
 				&enginePins.alternatorPin,
 				engineConfiguration->alternatorPwmFrequency, 0);
 }
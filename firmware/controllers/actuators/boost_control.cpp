@@ -324,7 +324,7 @@ void startBoostPin() {
 	startSimplePwm(
 		&boostPwmControl,
 		"Boost",
-		&engine->scheduler,
+		getLowPriorityScheduler(),
 		&enginePins.boostPin,
 		engineConfiguration->boostPwmFrequency,
 		/*dutyCycle*/0
@@ -99,7 +99,7 @@ DcMotor* initDcMotor(const char *disPinMsg,const dc_io& io, size_t index, bool u
 		io.disablePin,
 		// todo You would not believe how you invert TLE9201 #4579
 		engineConfiguration->stepperDcInvertedPins,
-		&engine->scheduler,
+		getLowPriorityScheduler(),
 		engineConfiguration->etbFreq
 	);
 
@@ -117,7 +117,7 @@ DcMotor* initDcMotor(brain_pin_e coil_p, brain_pin_e coil_m, size_t index) {
 		nullptr,
 		Gpio::Unassigned, /* pinDisable */
 		engineConfiguration->stepperDcInvertedPins,
-		&engine->scheduler,
+		getLowPriorityScheduler(),
 		engineConfiguration->etbFreq /* same in case of stepper? */
 	);
 
@@ -195,7 +195,6 @@ void EtbController::onConfigurationChange(pid_s* previousConfiguration) {
 	if (m_motor && !m_pid.isSame(previousConfiguration)) {
 		m_shouldResetPid = true;
 	}
-	doInitElectronicThrottle();
 }
 
 void EtbController::showStatus() {
@@ -877,10 +876,67 @@ void setDefaultEtbParameters() {
 //	engineConfiguration->etbJamTimeout = 1;
 }
 
+// Last doInitElectronicThrottle() left something to retry: a throttle without its sensors, pedal without throttle
+static bool isDcInitIncomplete = true;
+
+/**
+ * ETB init checks which position sensors exist, so besides motor configuration this covers everything
+ * initTps() decides TPS/PPS/wastegate/idle position sensor presence from.
+ */
+static bool isDcSensorConfigurationChanged(engine_configuration_s const * previousConfiguration) {
+	return isConfigurationFieldChanged(previousConfiguration, tps1_1AdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, tps1_2AdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2_1AdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2_2AdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalPositionAdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalPositionSecondAdcChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, wastegatePositionSensor)
+		|| isConfigurationFieldChanged(previousConfiguration, idlePositionChannel)
+		|| isConfigurationFieldChanged(previousConfiguration, sentEtbType)
+		// calibration: sensor is not registered when closed/open values are too close
+		|| isConfigurationFieldChanged(previousConfiguration, tpsMin)
+		|| isConfigurationFieldChanged(previousConfiguration, tpsMax)
+		|| isConfigurationFieldChanged(previousConfiguration, tps1SecondaryMin)
+		|| isConfigurationFieldChanged(previousConfiguration, tps1SecondaryMax)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2Min)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2Max)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2SecondaryMin)
+		|| isConfigurationFieldChanged(previousConfiguration, tps2SecondaryMax)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalUpVoltage)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalWOTVoltage)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalSecondaryUpVoltage)
+		|| isConfigurationFieldChanged(previousConfiguration, throttlePedalSecondaryWOTVoltage)
+		|| isConfigurationFieldChanged(previousConfiguration, wastegatePositionMin)
+		|| isConfigurationFieldChanged(previousConfiguration, wastegatePositionMax)
+		|| isConfigurationFieldChanged(previousConfiguration, idlePositionMin)
+		|| isConfigurationFieldChanged(previousConfiguration, idlePositionMax)
+		// bit fields
+		|| isConfigurationChanged(consumeObdSensors)
+		|| isConfigurationChanged(useFordRedundantTps)
+		|| isConfigurationChanged(useFordRedundantPps)
+		|| isConfigurationChanged(allowIdenticalPps);
+}
+
+bool isDcConfigurationChanged(engine_configuration_s const * previousConfiguration) {
+	return isConfigurationFieldChanged(previousConfiguration, etbFunctions)
+		|| isConfigurationFieldChanged(previousConfiguration, etbIo)
+		|| isConfigurationFieldChanged(previousConfiguration, etbFreq)
+		|| isDcSensorConfigurationChanged(previousConfiguration)
+		// bit fields
+		|| isConfigurationChanged(etb_use_two_wires)
+		|| isConfigurationChanged(stepperDcInvertedPins);
+}
+
 void onConfigurationChangeElectronicThrottleCallback(engine_configuration_s *previousConfiguration) {
 	for (int i = 0; i < ETB_COUNT; i++) {
 		etbControllers[i]->onConfigurationChange(&previousConfiguration->etb);
 	}
+
+	// Re-init restarts motor PWM and resets PID, PID parameters are handled by onConfigurationChange above.
+	// Sensors are re-created on every burn so a throttle which could not find them is retried every time.
+	if (isDcInitIncomplete || isDcConfigurationChanged(previousConfiguration)) {
+		doInitElectronicThrottle();
+	}
 }
 
 static const float defaultBiasBins[] = {
@@ -915,6 +971,7 @@ void doInitElectronicThrottle() {
 
 
 	bool anyEtbConfigured = false;
+	bool anyDcFailed = false;
 
 	// todo: technical debt: we still have DC motor code initialization in ETB-specific file while DC motors are used not just as ETB
 	// like DC motor wastegate code flow should probably NOT go through electronic_throttle.cpp right?
@@ -936,8 +993,11 @@ void doInitElectronicThrottle() {
 		bool dcConfigured = controller->init(func, motor, pid, pedal2TpsProvider());
 		bool etbConfigured = dcConfigured && controller->isEtbMode();
 		anyEtbConfigured |= etbConfigured;
+		anyDcFailed |= !dcConfigured;
 	}
 
+	isDcInitIncomplete = anyDcFailed || (hasPedal && !anyEtbConfigured);
+
 	if (!anyEtbConfigured) {
 		// It's not valid to have a PPS without any ETBs - check that at least one ETB was enabled along with the pedal
 		if (hasPedal) {
@@ -31,6 +31,8 @@ void setDefaultEtbParameters();
 void setBoschVNH2SP30Curve();
 
 void onConfigurationChangeElectronicThrottleCallback(engine_configuration_s *previousConfiguration);
+// true if ETB/DC motor hardware or the position sensors it depends on were re-configured
+bool isDcConfigurationChanged(engine_configuration_s const * previousConfiguration);
 void unregisterEtbPins();
 void setProteusHitachiEtbDefaults();
 
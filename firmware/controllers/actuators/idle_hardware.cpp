@@ -150,7 +150,7 @@ void initIdleHardware() {
 		 */
 		// todo: even for double-solenoid mode we can probably use same single SimplePWM
 		startSimplePwm(&idleSolenoidOpen, "Idle Valve Open",
-			&engine->scheduler,
+			getLowPriorityScheduler(),
 			&enginePins.idleSolenoidPin,
 			engineConfiguration->idle.solenoidFrequency, PERCENT_TO_DUTY(engineConfiguration->manIdlePosition));
 
@@ -161,7 +161,7 @@ void initIdleHardware() {
 			}
 
 			startSimplePwm(&idleSolenoidClose, "Idle Valve Close",
-				&engine->scheduler,
+				getLowPriorityScheduler(),
 				&enginePins.secondIdleSolenoidPin,
 				engineConfiguration->idle.solenoidFrequency, PERCENT_TO_DUTY(engineConfiguration->manIdlePosition));
 		}
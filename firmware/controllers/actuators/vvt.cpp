@@ -161,7 +161,7 @@ static void turnVvtPidOn(int index) {
 	}
 
 	startSimplePwmExt(&vvtPwms[index], vvtOutputNames[index],
-			&engine->scheduler,
+			getLowPriorityScheduler(),
 			engineConfiguration->vvtPins[index],
 			getVvtOutputPin(index),
 			engineConfiguration->vvtOutputFrequency, 0.1,
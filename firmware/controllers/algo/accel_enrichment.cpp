@@ -181,7 +181,12 @@ TpsAccelEnrichment::TpsAccelEnrichment() {
 	cb.setSize(4);
 }
 
-void TpsAccelEnrichment::onConfigurationChange(engine_configuration_s const* /*previousConfig*/) {
+void TpsAccelEnrichment::onConfigurationChange(engine_configuration_s const* previousConfig) {
+	// re-sizing clears TPS history, do not do that on unrelated burn
+	if (!isConfigurationFieldChanged(previousConfig, tpsAccelLookback)) {
+		return;
+	}
+
 	constexpr float slowCallbackPeriodSecond = SLOW_CALLBACK_PERIOD_MS / 1000.0f;
 	int length = engineConfiguration->tpsAccelLookback / slowCallbackPeriodSecond;
 
@@ -48,6 +48,11 @@
 #include "gpio/tle8888.h"
 #endif
 
+#if EFI_TUNER_STUDIO
+#include "ts_config_staging.h"
+#include "ts_page_crc.h"
+#endif /* EFI_TUNER_STUDIO */
+
 #if EFI_ENGINE_SNIFFER
 #include "engine_sniffer.h"
 extern int waveChartUsedSize;
@@ -183,6 +188,10 @@ void Engine::periodicSlowCallback() {
 	updateDynoView();
 #endif
 
+#if EFI_TUNER_STUDIO
+	updateConfigPageCrc();
+#endif // EFI_TUNER_STUDIO
+
 	slowCallBackWasInvoked = true;
 
 #if EFI_PROD_CODE
@@ -202,6 +211,13 @@ void Engine::updateSlowSensors() {
 	float rpm = Sensor::getOrZero(SensorType::Rpm);
 	triggerCentral.isEngineSnifferEnabled = rpm < engineConfiguration->engineSnifferRpmThreshold;
 	getEngineState()->sensorChartMode = rpm < engineConfiguration->sensorSnifferRpmThreshold ? engineConfiguration->sensorChartMode : SC_OFF;
+
+	triggerCentral.triggerState.updateSyncGapRatio();
+	for (int bankIndex = 0; bankIndex < BANKS_COUNT; bankIndex++) {
+		for (int camIndex = 0; camIndex < CAMS_PER_BANK; camIndex++) {
+			triggerCentral.vvtState[bankIndex][camIndex].updateSyncGapRatio();
+		}
+	}
 #endif // EFI_SHAFT_POSITION_INPUT
 }
 
@@ -324,7 +340,7 @@ void Engine::preCalculate() {
 	// we have a hack here - we rely on the fact that engineMake is the first of three relevant fields
 	engine->outputChannels.engineMakeCodeNameCrc16 = crc32(engineConfiguration->engineMake, 3 * VEHICLE_INFO_SIZE);
 
-	engine->outputChannels.tuneCrc16 = crc32(config, sizeof(persistent_config_s));
+	engine->outputChannels.tuneCrc16 = fastCrc32(config, sizeof(persistent_config_s));
 #endif /* EFI_TUNER_STUDIO */
 }
 
@@ -334,6 +350,8 @@ void Engine::OnTriggerStateProperState(efitick_t nowNt) {
 }
 
 void Engine::OnTriggerSynchronizationLost() {
+	perfTraceTrigger(PerfTraceTrigger::SyncLoss);
+
 	// Needed for early instant-RPM detection
 	rpmCalculator.setStopSpinning();
 
@@ -547,6 +565,11 @@ injection_mode_e getCurrentInjectionMode() {
 void Engine::periodicFastCallback() {
 	ScopePerf pc(PE::EnginePeriodicFastCallback);
 
+#if EFI_TUNER_STUDIO
+	// Safe point: nothing below is half way through reading tables
+	publishStagedConfigWrites();
+#endif // EFI_TUNER_STUDIO
+
 #if EFI_MAP_AVERAGING
 	refreshMapAveragingPreCalc();
 #endif
@@ -557,6 +580,11 @@ void Engine::periodicFastCallback() {
 	speedoUpdate();
 
 	engineModules.apply_all([](auto & m) { m.onFastCallback(); });
+
+#if EFI_ENGINE_CONTROL && EFI_SHAFT_POSITION_INPUT
+	// last: pulses depend on fuel mass, injector model and wall wetting computed above
+	injectionEvents.preparePulses(getTimeNowNt());
+#endif // EFI_ENGINE_CONTROL && EFI_SHAFT_POSITION_INPUT
 }
 
 EngineRotationState * getEngineRotationState() {
@@ -575,6 +603,14 @@ Scheduler *getScheduler() {
 	return &engine->scheduler;
 }
 
+Scheduler *getLowPriorityScheduler() {
+#if EFI_LOW_PRIORITY_SCHEDULER
+	return &engine->lowPriorityScheduler;
+#else
+	return &engine->scheduler;
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+}
+
 #if EFI_SHAFT_POSITION_INPUT
 TriggerCentral * getTriggerCentral() {
 	return &engine->triggerCentral;
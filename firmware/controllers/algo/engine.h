@@ -250,6 +250,10 @@ public:
 #if EFI_SIGNAL_EXECUTOR_ONE_TIMER
   // while theoretically PROD could be using EFI_SIGNAL_EXECUTOR_SLEEP, as of 2024 all PROD uses SingleTimerExecutor
 	SingleTimerExecutor scheduler;
+#if EFI_LOW_PRIORITY_SCHEDULER
+	// software PWM and other outputs not synchronous with engine position, see getLowPriorityScheduler()
+	SingleTimerExecutor lowPriorityScheduler{US2NT(8), setHardwareLowPrioritySchedulerTimer};
+#endif // EFI_LOW_PRIORITY_SCHEDULER
 #endif
 #if EFI_SIGNAL_EXECUTOR_SLEEP
   // at the moment this one is used exclusively by x86 simulator it should theoretically be possible to make it available in embedded if needed
@@ -66,6 +66,7 @@
 #if EFI_TUNER_STUDIO
 #include "tunerstudio.h"
 #endif
+#include "ts_page_crc.h"
 
 #define TS_DEFAULT_SPEED 38400
 
@@ -96,11 +97,31 @@ void rememberCurrentConfiguration() {
     hasRememberedConfiguration = true;
 }
 
+bool isConfigurationRangeChanged(engine_configuration_s const * previousConfig, size_t offset, size_t size) {
+	if (!previousConfig) {
+		return true;
+	}
+#if EFI_ACTIVE_CONFIGURATION_IN_FLASH
+	if (previousConfig == &activeConfiguration && isActiveConfigurationVoid) {
+		return true;
+	}
+#endif /* EFI_ACTIVE_CONFIGURATION_IN_FLASH */
+
+	const uint8_t *previous = reinterpret_cast<const uint8_t *>(previousConfig) + offset;
+	const uint8_t *current = reinterpret_cast<const uint8_t *>(engineConfiguration) + offset;
+	return memcmp(previous, current, size) != 0;
+}
+
 static void wipeString(char *string, int size) {
+	bool isChanged = false;
 	// we have to reset bytes after \0 symbol in order to calculate correct tune CRC from MSQ file
 	for (int i = strlen(string) + 1; i < size; i++) {
+		isChanged |= string[i] != 0;
 		string[i] = 0;
 	}
+	if (isChanged) {
+		invalidateConfigPageCrc(reinterpret_cast<uint8_t*>(string) - reinterpret_cast<uint8_t*>(config), size);
+	}
 }
 
 static void wipeStrings() {
@@ -696,6 +717,7 @@ void resetConfigurationExt(configuration_callback_t boardCallback, engine_type_e
 	engineConfiguration->engineType = engineType;
 	applyEngineType(engineType);
 	applyNonPersistentConfiguration();
+	invalidateConfigFieldCrc(*config);
 }
 
 void emptyCallbackWithConfiguration(engine_configuration_s * p_engineConfiguration) {
@@ -107,6 +107,19 @@ extern bool isActiveConfigurationVoid;
 
 #define isPinOrModeChanged(pin, mode) (isConfigurationChanged(pin) || isConfigurationChanged(mode))
 
+/**
+ * onConfigurationChange(previousConfig) is invoked for every module on every burn, use these to only
+ * re-initialize when the part of configuration the module depends on was actually changed.
+ * Works for whole structs and arrays, null previousConfig (initial invocation) counts as changed.
+ */
+bool isConfigurationRangeChanged(engine_configuration_s const * previousConfig, size_t offset, size_t size);
+#define isConfigurationFieldChanged(previousConfig, field) isConfigurationRangeChanged(previousConfig, \
+	offsetof(engine_configuration_s, field), sizeof(engineConfiguration->field))
+// Everything from first to last field inclusive, for groups of adjacent fields
+#define isConfigurationFieldRangeChanged(previousConfig, first, last) isConfigurationRangeChanged(previousConfig, \
+	offsetof(engine_configuration_s, first), \
+	offsetof(engine_configuration_s, last) + sizeof(engineConfiguration->last) - offsetof(engine_configuration_s, first))
+
 // total number of outputs: low side + high side
 int getBoardMetaOutputsCount();
 int getBoardMetaLowSideOutputsCount();
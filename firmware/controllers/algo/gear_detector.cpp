@@ -51,8 +51,11 @@ void GearDetector::initGearDetector() {
 	Register();
 }
 
-void GearDetector::onConfigurationChange(engine_configuration_s const * /*previousConfig*/) {
-    initGearDetector();
+void GearDetector::onConfigurationChange(engine_configuration_s const * previousConfig) {
+	if (isConfigurationFieldChanged(previousConfig, totalGearsCount)
+			|| isConfigurationFieldChanged(previousConfig, gearRatio)) {
+		initGearDetector();
+	}
 }
 
 void GearDetector::onSlowCallback() {
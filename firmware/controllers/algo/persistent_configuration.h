@@ -10,6 +10,7 @@
 #include "generated_lookup_engine_configuration.h"
 
 #include "rusefi/crc.h"
+#include "fast_crc32.h"
 
 typedef struct {
 	int version;
@@ -18,6 +19,6 @@ typedef struct {
 	uint32_t crc;
 
 	uint32_t getCrc() {
-		return crc32(&persistentConfiguration, sizeof(persistent_config_s));
+		return fastCrc32(&persistentConfiguration, sizeof(persistent_config_s));
 	}
 } persistent_config_container_s;
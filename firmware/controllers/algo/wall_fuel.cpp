@@ -12,9 +12,26 @@ void WallFuel::resetWF() {
 }
 
 float WallFuel::adjust(float desiredMassGrams) {
+	WallFuelAdjustment adjustment = predict(desiredMassGrams);
+	commit(adjustment);
+	return adjustment.commandedMassGrams;
+}
+
+void WallFuel::commit(const WallFuelAdjustment& adjustment) {
 	invocationCounter++;
+	wallFuel = adjustment.wallFuelNext;
+	wallFuelCorrection = adjustment.wallFuelCorrection;
+}
+
+WallFuelAdjustment WallFuel::predict(float desiredMassGrams) const {
+	// by default pass value through and leave film as is
+	WallFuelAdjustment result;
+	result.commandedMassGrams = desiredMassGrams;
+	result.wallFuelNext = wallFuel;
+	result.wallFuelCorrection = wallFuelCorrection;
+
 	if (std::isnan(desiredMassGrams)) {
-		return desiredMassGrams;
+		return result;
 	}
 
 	ScopePerf perf(PE::WallFuelAdjust);
@@ -45,7 +62,7 @@ float WallFuel::adjust(float desiredMassGrams) {
 
 	// If disabled, pass value through
 	if (!engine->module<WallFuelController>()->getEnable()) {
-		return desiredMassGrams;
+		return result;
 	}
 
 	float alpha = engine->module<WallFuelController>()->getAlpha();
@@ -64,9 +81,10 @@ float WallFuel::adjust(float desiredMassGrams) {
 	// remainder on walls from last time + new from this time
 	float fuelFilmMassNext = alpha * fuelFilmMass + beta * M_cmd;
 
-	wallFuel = fuelFilmMassNext;
-	wallFuelCorrection = M_cmd - desiredMassGrams;
-	return M_cmd;
+	result.commandedMassGrams = M_cmd;
+	result.wallFuelNext = fuelFilmMassNext;
+	result.wallFuelCorrection = M_cmd - desiredMassGrams;
+	return result;
 }
 
 float WallFuel::getWallFuel() const {
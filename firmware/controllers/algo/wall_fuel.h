@@ -8,6 +8,17 @@
 #include "wall_fuel_state_generated.h"
 #include "engine_module.h"
 
+/**
+ * Result of wall wetting math for one squirt, see WallFuel::predict()
+ */
+struct WallFuelAdjustment {
+	// fuel to command, grams
+	float commandedMassGrams = 0;
+	// film mass once this squirt is injected
+	float wallFuelNext = 0;
+	float wallFuelCorrection = 0;
+};
+
 /**
  * Wall wetting, also known as fuel film
  * See https://github.com/rusefi/rusefi/issues/151 for the theory
@@ -19,6 +30,12 @@ public:
 	 * @return total adjusted fuel squirt mass in grams once wall wetting is taken into effect
 	 */
 	float adjust(float desiredMassGrams);
+	/**
+	 * Same as adjust() but without updating fuel film state, so that the squirt could be computed ahead of time.
+	 * Film state is updated once the squirt is actually injected, see commit()
+	 */
+	WallFuelAdjustment predict(float desiredMassGrams) const;
+	void commit(const WallFuelAdjustment& adjustment);
 	float getWallFuel() const;
 	void resetWF();
 	int invocationCounter = 0;
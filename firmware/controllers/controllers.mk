@@ -45,6 +45,7 @@ CONTROLLERS_SRC_CPP = \
 	$(CONTROLLERS_DIR)/flash_main.cpp \
 	$(CONTROLLERS_DIR)/storage.cpp \
 	$(CONTROLLERS_DIR)/mfs_storage.cpp \
+	$(CONTROLLERS_DIR)/settings_journal.cpp \
 	$(CONTROLLERS_DIR)/bench_test.cpp \
 	$(CONTROLLERS_DIR)/can/obd2.cpp \
 	$(CONTROLLERS_DIR)/can/can_verbose.cpp \
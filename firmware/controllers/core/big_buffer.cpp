@@ -2,29 +2,63 @@
 
 #include "big_buffer.h"
 
-static BigBufferUser s_currentUser;
+#define BIG_BUFFER_BLOCK_COUNT (BIG_BUFFER_SIZE / BIG_BUFFER_BLOCK_SIZE)
+
+// owner of each block, partition is a run of consecutive blocks with the same owner
+static BigBufferUser s_blockOwner[BIG_BUFFER_BLOCK_COUNT];
 // uint32_t type to get 4-byte alignment
 // alignment is required since we sometimes allocate objects in the buffer (like Timer of CompositeBuffer)
 // we've only observed issue on F7 in -Os compiler configuration but technically all processors care
 static uint32_t s_bigBuffer[BIG_BUFFER_SIZE / sizeof(uint32_t)];
 
-#if EFI_UNIT_TEST
-BigBufferUser getBigBufferCurrentUser() {
-  return s_currentUser;
-}
+static_assert(BIG_BUFFER_BLOCK_SIZE % sizeof(uint32_t) == 0);
+
+// Handles are created and released from both threads and critical sections (tooth logger), so we can't just chSysLock()
+class BigBufferLock {
+public:
+	BigBufferLock() {
+#if !EFI_UNIT_TEST
+		m_status = chSysGetStatusAndLockX();
 #endif // EFI_UNIT_TEST
+	}
 
-static void releaseBuffer(void* bufferPtr, BigBufferUser user) {
-	if (bufferPtr != &s_bigBuffer || user != s_currentUser) {
-		// todo: panic!
+	~BigBufferLock() {
+#if !EFI_UNIT_TEST
+		chSysRestoreStatusX(m_status);
+#endif // EFI_UNIT_TEST
 	}
 
-	s_currentUser = BigBufferUser::None;
+#if !EFI_UNIT_TEST
+private:
+	syssts_t m_status;
+#endif // EFI_UNIT_TEST
+};
+
+static uint8_t* blockAddress(size_t blockIdx) {
+	return reinterpret_cast<uint8_t*>(s_bigBuffer) + blockIdx * BIG_BUFFER_BLOCK_SIZE;
 }
 
-BigBufferHandle::BigBufferHandle(void* buffer, BigBufferUser user)
+static void releaseBuffer(void* bufferPtr, BigBufferUser user, size_t size) {
+	BigBufferLock lock;
+
+	size_t offset = reinterpret_cast<uint8_t*>(bufferPtr) - blockAddress(0);
+	size_t first = offset / BIG_BUFFER_BLOCK_SIZE;
+	size_t count = size / BIG_BUFFER_BLOCK_SIZE;
+
+	for (size_t i = first; i < first + count && i < BIG_BUFFER_BLOCK_COUNT; i++) {
+		if (s_blockOwner[i] != user) {
+			// todo: panic!
+			continue;
+		}
+
+		s_blockOwner[i] = BigBufferUser::None;
+	}
+}
+
+BigBufferHandle::BigBufferHandle(void* buffer, BigBufferUser user, size_t size)
 	: m_bufferPtr(buffer)
 	, m_user(user)
+	, m_size(size)
 {
 }
 
@@ -35,12 +69,15 @@ BigBufferHandle::BigBufferHandle(BigBufferHandle&& other) {
 
 	m_user = other.m_user;
 	other.m_user = BigBufferUser::None;
+
+	m_size = other.m_size;
+	other.m_size = 0;
 }
 
 BigBufferHandle& BigBufferHandle::operator= (BigBufferHandle&& other) {
 	if (this != &other) {
 		if (m_bufferPtr) {
-			releaseBuffer(m_bufferPtr, m_user);
+			releaseBuffer(m_bufferPtr, m_user, m_size);
 		}
 		// swap contents of the two objects
 		m_bufferPtr = other.m_bufferPtr;
@@ -48,23 +85,90 @@ BigBufferHandle& BigBufferHandle::operator= (BigBufferHandle&& other) {
 
 		m_user = other.m_user;
 		other.m_user = BigBufferUser::None;
+
+		m_size = other.m_size;
+		other.m_size = 0;
 	}
 	return *this;
 }
 
 BigBufferHandle::~BigBufferHandle() {
 	if (m_bufferPtr) {
-		releaseBuffer(m_bufferPtr, m_user);
+		releaseBuffer(m_bufferPtr, m_user, m_size);
 	}
 }
 
-BigBufferHandle getBigBuffer(BigBufferUser user) {
-	if (s_currentUser != BigBufferUser::None) {
-		// fatal
+BigBufferHandle getBigBuffer(BigBufferUser user, size_t size) {
+	size_t count = (size + BIG_BUFFER_BLOCK_SIZE - 1) / BIG_BUFFER_BLOCK_SIZE;
+	if (user == BigBufferUser::None || count == 0 || count > BIG_BUFFER_BLOCK_COUNT) {
 		return {};
 	}
 
-	s_currentUser = user;
+	BigBufferLock lock;
+
+	// first fit: keeps the far end of the buffer free for big requests
+	size_t runLength = 0;
+	for (size_t i = 0; i < BIG_BUFFER_BLOCK_COUNT; i++) {
+		if (s_blockOwner[i] != BigBufferUser::None) {
+			runLength = 0;
+			continue;
+		}
+
+		runLength++;
+		if (runLength == count) {
+			size_t first = i + 1 - count;
+			for (size_t j = first; j <= i; j++) {
+				s_blockOwner[j] = user;
+			}
+
+			return BigBufferHandle(blockAddress(first), user, count * BIG_BUFFER_BLOCK_SIZE);
+		}
+	}
+
+	// fatal
+	return {};
+}
+
+size_t getBigBufferLargestFree() {
+	BigBufferLock lock;
+
+	size_t bestLength = 0;
+	size_t runLength = 0;
+	for (size_t i = 0; i < BIG_BUFFER_BLOCK_COUNT; i++) {
+		if (s_blockOwner[i] != BigBufferUser::None) {
+			runLength = 0;
+			continue;
+		}
+
+		runLength++;
+		if (runLength > bestLength) {
+			bestLength = runLength;
+		}
+	}
+
+	return bestLength * BIG_BUFFER_BLOCK_SIZE;
+}
+
+size_t getBigBufferUsage(BigBufferUser user) {
+	BigBufferLock lock;
+
+	size_t count = 0;
+	for (size_t i = 0; i < BIG_BUFFER_BLOCK_COUNT; i++) {
+		if (s_blockOwner[i] == user) {
+			count++;
+		}
+	}
+
+	return count * BIG_BUFFER_BLOCK_SIZE;
+}
 
-	return BigBufferHandle(s_bigBuffer, user);
+void printBigBufferUsage() {
+	efiPrintf("big buffer %d bytes, %d byte blocks, largest free %d", BIG_BUFFER_SIZE, BIG_BUFFER_BLOCK_SIZE, (int)getBigBufferLargestFree());
+	efiPrintf("free %d", (int)getBigBufferUsage(BigBufferUser::None));
+	efiPrintf("tooth logger %d", (int)getBigBufferUsage(BigBufferUser::ToothLogger));
+	efiPrintf("perf trace %d", (int)getBigBufferUsage(BigBufferUser::PerfTrace));
+	efiPrintf("trigger scope %d", (int)getBigBufferUsage(BigBufferUser::TriggerScope));
+	efiPrintf("knock spectrogram %d", (int)getBigBufferUsage(BigBufferUser::KnockSpectrogram));
+	efiPrintf("engine sniffer %d", (int)getBigBufferUsage(BigBufferUser::EngineSniffer));
+	efiPrintf("lua bytecode %d", (int)getBigBufferUsage(BigBufferUser::LuaBytecode));
 }
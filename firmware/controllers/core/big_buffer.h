@@ -1,4 +1,5 @@
 // This file handles the "big buffer" - a shared buffer that can be used by multiple users depending on which function is enabled
+// The buffer is split into blocks, each user holds a contiguous partition so that several diagnostic features could run at the same time
 
 #pragma once
 
@@ -6,6 +7,11 @@
 #define BIG_BUFFER_SIZE 8192
 #endif
 
+// allocation granularity
+#define BIG_BUFFER_BLOCK_SIZE 256
+
+static_assert(BIG_BUFFER_SIZE % BIG_BUFFER_BLOCK_SIZE == 0);
+
 enum class BigBufferUser {
 	None,
 	ToothLogger,
@@ -13,12 +19,14 @@ enum class BigBufferUser {
 	TriggerScope,
 	// todo: actually start using this!
 	KnockSpectrogram,
+	EngineSniffer,
+	LuaBytecode,
 };
 
 class BigBufferHandle {
 public:
 	BigBufferHandle() = default;
-	BigBufferHandle(void* buffer, BigBufferUser user);
+	BigBufferHandle(void* buffer, BigBufferUser user, size_t size);
 	~BigBufferHandle();
 
 	// But allow moving (passing ownership of the buffer)
@@ -40,13 +48,25 @@ public:
 		return reinterpret_cast<TBuffer*>(m_bufferPtr);
 	}
 
+	// size of this partition in bytes, could be more than requested
 	size_t size() const {
-		return BIG_BUFFER_SIZE;
+		return m_size;
 	}
 
 private:
 	void* m_bufferPtr = nullptr;
 	BigBufferUser m_user = BigBufferUser::None;
+	size_t m_size = 0;
 };
 
-BigBufferHandle getBigBuffer(BigBufferUser user);
+/**
+ * Allocates a partition of at least 'size' bytes. Partition start is 4-byte aligned.
+ * Returns empty handle if there is not enough contiguous free space.
+ */
+BigBufferHandle getBigBuffer(BigBufferUser user, size_t size = BIG_BUFFER_SIZE);
+
+// Largest partition getBigBuffer() could allocate right now
+size_t getBigBufferLargestFree();
+// Bytes currently held by given user, BigBufferUser::None for free space
+size_t getBigBufferUsage(BigBufferUser user);
+void printBigBufferUsage();
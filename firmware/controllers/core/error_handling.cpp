@@ -594,6 +594,8 @@ void firmwareError(ObdCode code, const char *fmt, ...) {
 		return;
 	hasCriticalFirmwareErrorFlag = true;
 
+	perfTraceTrigger(PerfTraceTrigger::FirmwareError);
+
 	// construct error message
 	if (indexOf(fmt, '%') == -1) {
 		/**
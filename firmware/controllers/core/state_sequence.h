@@ -8,6 +8,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
 #include "rusefi_enums.h"
 #include <rusefi/expected.h>
 
@@ -38,6 +39,10 @@ typedef enum {
 // todo https://github.com/rusefi/rusefi/issues/3003
 #define PWM_PHASE_MAX_COUNT 280
 #endif /* PWM_PHASE_MAX_COUNT */
+// Cam wheels have just a few teeth, no need to reserve crank wheel size for each of them
+#ifndef VVT_PHASE_MAX_COUNT
+#define VVT_PHASE_MAX_COUNT 32
+#endif /* VVT_PHASE_MAX_COUNT */
 // todo: rename to TRIGGER_CHANNEL_COUNT?
 #define PWM_PHASE_MAX_WAVE_PER_PWM 2
 
@@ -109,3 +114,47 @@ private:
 	uint8_t waveForm[max_phase];
 };
 
+/**
+ * Same as MultiChannelStateSequenceWithData but arrays are owned by someone else,
+ * this way same non-template code can work with sequences of different capacity
+ */
+class MultiChannelStateSequenceView final : public MultiChannelStateSequence {
+public:
+	MultiChannelStateSequenceView(float *switchTimes, uint8_t *waveForm, size_t maxPhase)
+		: m_switchTimes(switchTimes)
+		, m_waveForm(waveForm)
+		, m_maxPhase(maxPhase)
+	{
+	}
+
+	float getSwitchTime(int phaseIndex) const override {
+		return m_switchTimes[phaseIndex];
+	}
+
+	pin_state_t getChannelState(int channelIndex, int phaseIndex) const override {
+		return ((m_waveForm[phaseIndex] >> channelIndex) & 1) ? TriggerValue::RISE : TriggerValue::FALL;
+	}
+
+	void reset() {
+		waveCount = 0;
+	}
+
+	void setSwitchTime(const int phaseIndex, const float value) {
+		m_switchTimes[phaseIndex] = value;
+	}
+
+	void setChannelState(const int channelIndex, const int phaseIndex, pin_state_t state) {
+		uint8_t & ref = m_waveForm[phaseIndex];
+		ref = (ref & ~(1U << channelIndex)) | ((state == TriggerValue::RISE ? 1 : 0) << channelIndex);
+	}
+
+	size_t getMaxPhaseCount() const {
+		return m_maxPhase;
+	}
+
+private:
+	float * const m_switchTimes;
+	uint8_t * const m_waveForm;
+	const size_t m_maxPhase;
+};
+
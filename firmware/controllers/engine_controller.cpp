@@ -49,10 +49,12 @@
 #include "accelerometer.h"
 #include "vvt.h"
 #include "boost_control.h"
+#include "ts_page_crc.h"
 #include "launch_control.h"
 #include "tachometer.h"
 #include "speedometer.h"
 #include "gppwm.h"
+#include "periodic_executor.h"
 #include "date_stamp.h"
 #include "rusefi_lua.h"
 #include "buttonshift.h"
@@ -142,12 +144,12 @@ class PeriodicSlowController : public PeriodicTimerController {
 static PeriodicFastController fastController;
 static PeriodicSlowController slowController;
 
-class EngineStateBlinkingTask : public PeriodicTimerController {
-	int getPeriodMs() override {
-		return 50;
-	}
+class EngineStateBlinkingTask : public PeriodicJob {
+public:
+	EngineStateBlinkingTask() : PeriodicJob("EngineStateBlink", PeriodicLane::Low, 20) { }
 
-	void PeriodicTask() override {
+private:
+	void PeriodicTask(efitick_t) override {
 #if EFI_SHAFT_POSITION_INPUT
 		bool is_running = engine->rpmCalculator.isRunning();
 #else
@@ -299,6 +301,7 @@ static void setBit(const char *offsetStr, const char *bitStr, const char *valueS
 	}
 	int *ptr = (int *) (&((char *) engineConfiguration)[offset]);
 	*ptr ^= (-value ^ *ptr) & (1 << bit);
+	invalidateConfigFieldCrc(*ptr);
 	/**
 	 * this response is part of rusEfi console API
 	 */
@@ -311,6 +314,7 @@ static void setShort(const int offset, const int value) {
 		return;
 	uint16_t *ptr = (uint16_t *) (&((char *) engineConfiguration)[offset]);
 	*ptr = (uint16_t) value;
+	invalidateConfigFieldCrc(*ptr);
 	getShort(offset);
 	incrementGlobalConfigurationVersion("setShort");
 }
@@ -320,6 +324,7 @@ static void setByte(const int offset, const int value) {
 		return;
 	uint8_t *ptr = (uint8_t *) (&((char *) engineConfiguration)[offset]);
 	*ptr = (uint8_t) value;
+	invalidateConfigFieldCrc(*ptr);
 	getByte(offset);
 	incrementGlobalConfigurationVersion("setByte");
 }
@@ -351,6 +356,7 @@ static void setInt(const int offset, const int value) {
 		return;
 	int *ptr = (int *) (&((char *) engineConfiguration)[offset]);
 	*ptr = value;
+	invalidateConfigFieldCrc(*ptr);
 	getInt(offset);
 	incrementGlobalConfigurationVersion("setInt");
 }
@@ -381,6 +387,7 @@ static void setFloat(const char *offsetStr, const char *valueStr) {
 	}
 	float *ptr = (float *) (&((char *) engineConfiguration)[offset]);
 	*ptr = value;
+	invalidateConfigFieldCrc(*ptr);
 	getFloat(offset);
 	incrementGlobalConfigurationVersion("setFloat");
 }
@@ -6,6 +6,7 @@
  */
 
 #include "pch.h"
+#include "thread_profiler.h"
 
 static uint8_t nextThreadId = 0;
 void threadInitHook(void* vtp) {
@@ -14,21 +15,32 @@ void threadInitHook(void* vtp) {
 	tp->threadId = ++nextThreadId;
 }
 
-#if ENABLE_PERF_TRACE
 void irqEnterHook() {
+#if EFI_THREAD_PROFILER
+	threadProfilerOnIrqEnter();
+#endif // EFI_THREAD_PROFILER
+#if ENABLE_PERF_TRACE
 	perfEventBegin(PE::ISR);
+#endif /* ENABLE_PERF_TRACE */
 }
 
 void irqExitHook() {
+#if ENABLE_PERF_TRACE
 	perfEventEnd(PE::ISR);
+#endif /* ENABLE_PERF_TRACE */
+#if EFI_THREAD_PROFILER
+	threadProfilerOnIrqExit();
+#endif // EFI_THREAD_PROFILER
 }
 
-void contextSwitchHook() {
-	perfEventInstantGlobal(PE::ContextSwitch);
-}
-
+void contextSwitchHook(void* otp) {
+#if EFI_THREAD_PROFILER
+	// No lock required, this is already under lock
+	threadProfilerOnContextSwitch(reinterpret_cast<thread_t*>(otp));
 #else
-void irqEnterHook() {}
-void irqExitHook() {}
-void contextSwitchHook() {}
+	(void)otp;
+#endif // EFI_THREAD_PROFILER
+#if ENABLE_PERF_TRACE
+	perfEventInstantGlobal(PE::ContextSwitch);
 #endif /* ENABLE_PERF_TRACE */
+}
@@ -13,6 +13,41 @@
 
 #define MAX_WIRES_COUNT 2
 
+/**
+ * Injection pulse of one event, computed ahead of time in the fast callback so that
+ * trigger callback only has to check that it's still current and schedule it.
+ */
+struct InjectionPulse {
+	// Pulse is only valid while inputs it was computed from did not change
+	bool isCurrent(float desiredMassGrams, float stage2Fraction, float wallFuel, bool isSimultaneous) const {
+		return isValid
+			&& this->desiredMassGrams == desiredMassGrams
+			&& this->stage2Fraction == stage2Fraction
+			&& this->wallFuelBefore == wallFuel
+			&& this->isSimultaneous == isSimultaneous;
+	}
+
+	bool isValid = false;
+	bool isSimultaneous = false;
+	float desiredMassGrams = 0;
+	float stage2Fraction = 0;
+	float wallFuelBefore = 0;
+
+	WallFuelAdjustment wallFuel;
+	// fuel consumed by all injectors firing for this event, grams
+	float consumedMassGrams = 0;
+
+	// false for NaN, negative or too short pulse
+	bool shouldInject = false;
+	bool hasStage2Injection = false;
+	efidur_t durationStage1Nt = 0;
+	efidur_t durationStage2Nt = 0;
+
+	action_s startAction;
+	action_s endActionStage1;
+	action_s endActionStage2;
+};
+
 class InjectionEvent {
 public:
 	InjectionEvent();
@@ -22,6 +57,9 @@ public:
 	// Call this every decoded trigger tooth.  It will schedule any relevant events for this injector.
 	void onTriggerTooth(efitick_t nowNt, float currentPhase, float nextPhase);
 
+	// Call this from the fast callback once fuel mass and injector model are updated
+	void preparePulse();
+
 	WallFuel& getWallFuel();
 
 	void setIndex(uint8_t index) {
@@ -35,6 +73,9 @@ private:
 	// Compute the injection start angle, compensating for injection duration and injection phase settings.
 	expected<float> computeInjectionAngle() const;
 
+	// Wall wetting, injector model and pulse sanity checks for given fuel mass, fuel film state is not changed
+	void computePulse(InjectionPulse& pulse, float desiredMassGrams, float stage2Fraction);
+
 	/**
 	 * This is a performance optimization for IM_SIMULTANEOUS fuel strategy.
 	 * It's more efficient to handle all injectors together if that's the case
@@ -45,6 +86,10 @@ private:
 
 	WallFuel wallFuel;
 
+	// Double buffered: preparePulse() writes the one trigger callback is not reading, then flips the index
+	InjectionPulse pulses[2];
+	volatile uint8_t readyPulseIndex = 0;
+
 public:
 	// TODO: this should be private
 	InjectorOutputPin *outputs[MAX_WIRES_COUNT];
@@ -68,6 +113,15 @@ public:
 	// Call this every trigger tooth.  It will schedule all required injector events.
 	void onTriggerTooth(efitick_t nowNt, float currentPhase, float nextPhase);
 
+	/**
+	 * Call this from the fast callback: precomputes injection pulses for the trigger callback
+	 * and hands fuel injected since last invocation over to the trip computer.
+	 */
+	void preparePulses(efitick_t nowNt);
+
+	// fuel injected but not yet accounted by TripOdometer, grams
+	float pendingConsumedMassGrams = 0;
+
 	/**
 	 * this method schedules all fuel events for an engine cycle
 	 * Calculate injector opening angle, pins, and mode for all injectors
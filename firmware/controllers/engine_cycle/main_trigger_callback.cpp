@@ -75,44 +75,36 @@ static void turnInjectionPinLowStage2(InjectionEvent* event) {
 	}
 }
 
-void InjectionEvent::onTriggerTooth(efitick_t nowNt, float currentPhase, float nextPhase) {
-	auto eventAngle = injectionStartAngle;
-
-	// Determine whether our angle is going to happen before (or near) the next tooth
-	if (!isPhaseInRange(eventAngle, currentPhase, nextPhase)) {
-		return;
-	}
-
-	// Select fuel mass from the correct cylinder
-	auto injectionMassGrams = getEngineState()->injectionMass[this->cylinderNumber];
+void InjectionEvent::computePulse(InjectionPulse& pulse, float desiredMassGrams, float stage2Fraction) {
+	pulse.desiredMassGrams = desiredMassGrams;
+	pulse.stage2Fraction = stage2Fraction;
+	pulse.wallFuelBefore = wallFuel.getWallFuel();
+	pulse.isSimultaneous = isSimultaneous;
+	pulse.shouldInject = false;
 
 	// Perform wall wetting adjustment on fuel mass, not duration, so that
 	// it's correct during fuel pressure (injector flow) or battery voltage (deadtime) transients
 	// TODO: is it correct to wall wet on both pulses?
-	injectionMassGrams = wallFuel.adjust(injectionMassGrams);
-
-	// Disable staging in simultaneous mode
-	float stage2Fraction = isSimultaneous ? 0 : getEngineState()->injectionStage2Fraction;
+	pulse.wallFuel = wallFuel.predict(desiredMassGrams);
+	float injectionMassGrams = pulse.wallFuel.commandedMassGrams;
 
 	// Compute fraction of fuel on stage 2, remainder goes on stage 1
 	const float injectionMassStage2 = stage2Fraction * injectionMassGrams;
 	float injectionMassStage1 = injectionMassGrams - injectionMassStage2;
 
-#if EFI_VEHICLE_SPEED
 	{
-		// Log this fuel as consumed
+		// Fuel consumed once this pulse is injected
 
 		bool isCranking = getEngineRotationState()->isCranking();
 		int numberOfInjections = isCranking ? getNumberOfInjections(engineConfiguration->crankingInjectionMode) : getNumberOfInjections(engineConfiguration->injectionMode);
 
-		float actualInjectedMass = numberOfInjections * (injectionMassStage1 + injectionMassStage2);
-
-		engine->module<TripOdometer>()->consumeFuel(actualInjectedMass, nowNt);
+		pulse.consumedMassGrams = numberOfInjections * (injectionMassStage1 + injectionMassStage2);
 	}
-#endif // EFI_VEHICLE_SPEED
 
 	const floatms_t injectionDurationStage1 = engine->module<InjectorModelPrimary>()->getInjectionDuration(injectionMassStage1);
 	const floatms_t injectionDurationStage2 = injectionMassStage2 > 0 ? engine->module<InjectorModelSecondary>()->getInjectionDuration(injectionMassStage2) : 0;
+	// inputs are known now, from here on the pulse is good even if we decide not to inject
+	pulse.isValid = true;
 
 #if EFI_PRINTF_FUEL_DETAILS
 	if (printFuelDebug) {
@@ -151,19 +143,16 @@ void InjectionEvent::onTriggerTooth(efitick_t nowNt, float currentPhase, float n
 	// Only bother with the second stage if it's long enough to be relevant
 	bool hasStage2Injection = durationUsStage2 > 50;
 
-#if EFI_PRINTF_FUEL_DETAILS
-	if (printFuelDebug) {
-		InjectorOutputPin *output = outputs[0];
-		printf("handleFuelInjectionEvent fuelout %s injection_duration %dus engineCycleDuration=%.1fms\t\n", output->getName(), (int)durationUsStage1,
-				(int)MS2US(getCrankshaftRevolutionTimeMs(Sensor::getOrZero(SensorType::Rpm))) / 1000.0);
-	}
-#endif /*EFI_PRINTF_FUEL_DETAILS */
+	pulse.shouldInject = true;
+	pulse.hasStage2Injection = hasStage2Injection;
+	pulse.durationStage1Nt = US2NT((int)durationUsStage1);
+	pulse.durationStage2Nt = US2NT((int)durationUsStage2);
 
-	action_s startAction, endActionStage1, endActionStage2;
 	// We use different callbacks based on whether we're running sequential mode or not - everything else is the same
 	if (isSimultaneous) {
-		startAction = startSimultaneousInjection;
-		endActionStage1 = { &endSimultaneousInjection, this };
+		pulse.startAction = startSimultaneousInjection;
+		pulse.endActionStage1 = { &endSimultaneousInjection, this };
+		pulse.endActionStage2 = {};
 	} else {
 		uintptr_t startActionPtr = reinterpret_cast<uintptr_t>(this);
 
@@ -173,10 +162,63 @@ void InjectionEvent::onTriggerTooth(efitick_t nowNt, float currentPhase, float n
 		}
 
 		// sequential or batch
-		startAction = { &turnInjectionPinHigh, startActionPtr };
-		endActionStage1 = { &turnInjectionPinLow, this };
-		endActionStage2 = { &turnInjectionPinLowStage2, this };
+		pulse.startAction = { &turnInjectionPinHigh, startActionPtr };
+		pulse.endActionStage1 = { &turnInjectionPinLow, this };
+		pulse.endActionStage2 = { &turnInjectionPinLowStage2, this };
 	}
+}
+
+void InjectionEvent::preparePulse() {
+	// Disable staging in simultaneous mode
+	float stage2Fraction = isSimultaneous ? 0 : getEngineState()->injectionStage2Fraction;
+
+	// Trigger callback never preempts itself mid-read, so by the time we get here it's done with the other buffer
+	uint8_t nextIndex = readyPulseIndex ^ 1;
+	computePulse(pulses[nextIndex], getEngineState()->injectionMass[this->cylinderNumber], stage2Fraction);
+	readyPulseIndex = nextIndex;
+}
+
+void InjectionEvent::onTriggerTooth(efitick_t nowNt, float currentPhase, float nextPhase) {
+	auto eventAngle = injectionStartAngle;
+
+	// Determine whether our angle is going to happen before (or near) the next tooth
+	if (!isPhaseInRange(eventAngle, currentPhase, nextPhase)) {
+		return;
+	}
+
+	// Select fuel mass from the correct cylinder
+	auto injectionMassGrams = getEngineState()->injectionMass[this->cylinderNumber];
+
+	// Disable staging in simultaneous mode
+	float stage2Fraction = isSimultaneous ? 0 : getEngineState()->injectionStage2Fraction;
+
+	// Normally the pulse was computed by the fast callback, unless something changed since then:
+	// fresh sync, previous squirt of this event moved the fuel film, mode change etc
+	InjectionPulse latePulse;
+	const InjectionPulse* pulse = &pulses[readyPulseIndex];
+	if (!pulse->isCurrent(injectionMassGrams, stage2Fraction, wallFuel.getWallFuel(), isSimultaneous)) {
+		computePulse(latePulse, injectionMassGrams, stage2Fraction);
+		pulse = &latePulse;
+	}
+
+	wallFuel.commit(pulse->wallFuel);
+
+#if EFI_VEHICLE_SPEED
+	// Log this fuel as consumed, TripOdometer picks it up from the fast callback
+	getFuelSchedule()->pendingConsumedMassGrams += pulse->consumedMassGrams;
+#endif // EFI_VEHICLE_SPEED
+
+	if (!pulse->shouldInject) {
+		return;
+	}
+
+#if EFI_PRINTF_FUEL_DETAILS
+	if (printFuelDebug) {
+		InjectorOutputPin *output = outputs[0];
+		printf("handleFuelInjectionEvent fuelout %s injection_duration %dus engineCycleDuration=%.1fms\t\n", output->getName(), (int)NT2US(pulse->durationStage1Nt),
+				(int)MS2US(getCrankshaftRevolutionTimeMs(Sensor::getOrZero(SensorType::Rpm))) / 1000.0);
+	}
+#endif /*EFI_PRINTF_FUEL_DETAILS */
 
 	// Correctly wrap injection start angle
 	float angleFromNow = eventAngle - currentPhase;
@@ -185,31 +227,54 @@ void InjectionEvent::onTriggerTooth(efitick_t nowNt, float currentPhase, float n
 	}
 
 	// Schedule opening (stage 1 + stage 2 open together)
-	efitick_t startTime = scheduleByAngle(nullptr, nowNt, angleFromNow, startAction);
+	efitick_t startTime = scheduleByAngle(nullptr, nowNt, angleFromNow, pulse->startAction);
 
 	// Schedule closing stage 1
-	efitick_t turnOffTimeStage1 = startTime + US2NT((int)durationUsStage1);
-	getScheduler()->schedule("inj", nullptr, turnOffTimeStage1, endActionStage1);
+	efitick_t turnOffTimeStage1 = startTime + pulse->durationStage1Nt;
+	getScheduler()->schedule("inj", nullptr, turnOffTimeStage1, pulse->endActionStage1);
 
 	// Schedule closing stage 2 (if applicable)
-	if (hasStage2Injection && endActionStage2) {
-		efitick_t turnOffTimeStage2 = startTime + US2NT((int)durationUsStage2);
-		getScheduler()->schedule("inj stage 2", nullptr, turnOffTimeStage2, endActionStage2);
+	if (pulse->hasStage2Injection && pulse->endActionStage2) {
+		efitick_t turnOffTimeStage2 = startTime + pulse->durationStage2Nt;
+		getScheduler()->schedule("inj stage 2", nullptr, turnOffTimeStage2, pulse->endActionStage2);
 	}
 
 #if EFI_DEFAILED_LOGGING
-	printf("scheduling injection angle=%.2f/delay=%d injectionDuration=%d %d\r\n", angleFromNow, (int)NT2US(startTime - nowNt), (int)durationUsStage1, (int)durationUsStage2);
+	printf("scheduling injection angle=%.2f/delay=%d injectionDuration=%d %d\r\n", angleFromNow, (int)NT2US(startTime - nowNt), (int)NT2US(pulse->durationStage1Nt), (int)NT2US(pulse->durationStage2Nt));
 #endif
 #if EFI_DEFAILED_LOGGING
 	efiPrintf("handleFuel pin=%s eventIndex %d duration=%.2fms %d", outputs[0]->name,
 			injEventIndex,
-			injectionDurationStage1,
+			NT2US(pulse->durationStage1Nt) / 1000.0f,
 			getRevolutionCounter());
 	efiPrintf("handleFuel pin=%s delay=%.2f %d", outputs[0]->name, NT2US(startTime - nowNt),
 			getRevolutionCounter());
 #endif /* EFI_DEFAILED_LOGGING */
 }
 
+void FuelSchedule::preparePulses(efitick_t nowNt) {
+	if (isReady) {
+		for (size_t i = 0; i < engineConfiguration->cylindersCount; i++) {
+			elements[i].preparePulse();
+		}
+	}
+
+#if EFI_VEHICLE_SPEED
+	float consumedMassGrams;
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		consumedMassGrams = pendingConsumedMassGrams;
+		pendingConsumedMassGrams = 0;
+	}
+
+	if (consumedMassGrams > 0) {
+		engine->module<TripOdometer>()->consumeFuel(consumedMassGrams, nowNt);
+	}
+#else
+	UNUSED(nowNt);
+#endif // EFI_VEHICLE_SPEED
+}
+
 static void handleFuel(efitick_t nowNt, float currentPhase, float nextPhase) {
 	ScopePerf perf(PE::HandleFuel);
 
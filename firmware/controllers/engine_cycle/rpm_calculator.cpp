@@ -22,6 +22,9 @@
 #endif // EFI_SENSOR_CHART
 
 #include "engine_sniffer.h"
+#if EFI_LUA
+#include "lua_event_hooks.h"
+#endif // EFI_LUA
 
 // See RpmCalculator::checkIfSpinning()
 #ifndef NO_RPM_EVENTS_TIMEOUT_SECS
@@ -304,6 +307,9 @@ void rpmShaftPositionCallback(trigger_event_e ckpSignalType,
 		}
 
 		rpmState->onNewEngineCycle();
+#if EFI_LUA
+		onLuaEngineCycle();
+#endif // EFI_LUA
 	}
 
 #if EFI_SENSOR_CHART
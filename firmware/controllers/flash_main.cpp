@@ -23,11 +23,42 @@
 #endif
 
 #include "storage.h"
+#include "settings_journal.h"
 
 #include "runtime_state.h"
+#include "lua_bytecode_cache.h"
+#include "ts_page_crc.h"
 
 static bool needToWriteConfiguration = false;
 
+#if EFI_STORAGE_JOURNAL == TRUE
+#define SETTINGS_CHUNK_COUNT ((sizeof(persistentState) + EFI_SETTINGS_CHUNK_SIZE - 1) / EFI_SETTINGS_CHUNK_SIZE)
+static_assert(SETTINGS_CHUNK_COUNT <= EFI_SETTINGS_CHUNK_MAX_COUNT);
+static_assert(EFI_SETTINGS_CHUNK_FIRST_RECORD_ID + EFI_SETTINGS_CHUNK_MAX_COUNT <= MFS_CFG_MAX_RECORDS + 1);
+
+class SettingsStorageChunks : public SettingsChunkStore {
+public:
+	StorageStatus writeChunks(const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask) override {
+		return storageWriteChunks(EFI_SETTINGS_CHUNK_FIRST_RECORD_ID, ptr, size, chunkSize, dirtyMask);
+	}
+
+	StorageStatus readChunks(uint8_t *ptr, size_t size, size_t chunkSize) override {
+		return storageReadChunks(EFI_SETTINGS_CHUNK_FIRST_RECORD_ID, ptr, size, chunkSize);
+	}
+};
+
+static SettingsStorageChunks settingsStorageChunks;
+static SettingsJournal settingsJournal(settingsStorageChunks, reinterpret_cast<uint8_t *>(&persistentState),
+	sizeof(persistentState), EFI_SETTINGS_CHUNK_SIZE);
+#endif // EFI_STORAGE_JOURNAL
+
+// Allow saving setting to flash while engine is runnig.
+bool allowFlashWhileRunning() {
+	// either MCU supports flashing while executing
+	// either we store settings in external storage
+	return (mcuCanFlashWhileRunning() || (EFI_STORAGE_MFS_EXTERNAL == TRUE));
+}
+
 /**
  * https://sourceforge.net/p/rusefi/tickets/335/
  *
@@ -41,6 +72,19 @@ chibios_rt::Mailbox<msg_t, 16> flashWriterMb;
 #if EFI_STORAGE_MFS == TRUE
 /* in case of MFS we need more stack */
 static THD_WORKING_AREA(flashWriteStack, 3 * UTILITY_THREAD_STACK_SIZE);
+
+// Same rule as for burn, see engine_controller.cpp: unless flash is written without halting
+// the MCU, only while engine is stopped
+static bool canWriteFlashNow() {
+	if (allowFlashWhileRunning()) {
+		return true;
+	}
+#if EFI_SHAFT_POSITION_INPUT
+	return engine->triggerCentral.directSelfStimulation || engine->rpmCalculator.isStopped();
+#else
+	return true;
+#endif // EFI_SHAFT_POSITION_INPUT
+}
 #else
 static THD_WORKING_AREA(flashWriteStack, UTILITY_THREAD_STACK_SIZE);
 #endif
@@ -52,7 +96,19 @@ static void flashWriteThread(void*) {
 		msg_t ret;
 		msg_t msg;
 		// Wait for a request to come in
+#if EFI_STORAGE_MFS == TRUE
+		ret = flashWriterMb.fetch(&msg, TIME_MS2I(1000));
+		if (ret == MSG_TIMEOUT) {
+			// Nothing to write: good time to pack storage so next burn does not need to.
+			// Packing erases flash, same rule as for burn applies
+			if (canWriteFlashNow()) {
+				storageCompactIfNeeded();
+			}
+			continue;
+		}
+#else
 		ret = flashWriterMb.fetch(&msg, TIME_INFINITE);
+#endif
 		if (ret != MSG_OK) {
 			continue;
 		}
@@ -62,6 +118,10 @@ static void flashWriteThread(void*) {
 			writeToFlashNow();
 		} else if (msg == EFI_LTFT_RECORD_ID) {
 			engine->module<LongTermFuelTrim>()->store();
+#if EFI_LUA && EFI_LUA_BYTECODE_CACHE
+		} else if (msg == EFI_LUA_BYTECODE_RECORD_ID) {
+			luaStoreBytecode();
+#endif // EFI_LUA_BYTECODE_CACHE
 		} else {
 			efiPrintf("Requested to write unknown record id %ld", msg);
 		}
@@ -69,13 +129,6 @@ static void flashWriteThread(void*) {
 }
 #endif // EFI_FLASH_WRITE_THREAD
 
-// Allow saving setting to flash while engine is runnig.
-bool allowFlashWhileRunning() {
-	// either MCU supports flashing while executing
-	// either we store settings in external storage
-	return (mcuCanFlashWhileRunning() || (EFI_STORAGE_MFS_EXTERNAL == TRUE));
-}
-
 void setNeedToWriteConfiguration() {
 	efiPrintf("Scheduling configuration write");
 	needToWriteConfiguration = true;
@@ -99,6 +152,16 @@ void settingsLtftRequestWriteToFlash() {
 #endif // EFI_FLASH_WRITE_THREAD
 }
 
+bool luaBytecodeRequestWriteToFlash() {
+#if (EFI_FLASH_WRITE_THREAD == TRUE)
+	if (allowFlashWhileRunning()) {
+		msg_t id = EFI_LUA_BYTECODE_RECORD_ID;
+		return flashWriterMb.post(id, TIME_IMMEDIATE) == MSG_OK;
+	}
+#endif // EFI_FLASH_WRITE_THREAD
+	return false;
+}
+
 bool getNeedToWriteConfiguration() {
 	return needToWriteConfiguration;
 }
@@ -167,7 +230,13 @@ void writeToFlashNow() {
 	startWatchdog(WATCHDOG_FLASH_TIMEOUT_MS);
 
 	// Do actual write
-#if EFI_STORAGE_MFS == TRUE
+#if EFI_STORAGE_JOURNAL == TRUE
+	// Only chunks which were changed since last burn: milliseconds instead of seconds
+	if (settingsJournal.write() == StorageStatus::Ok) {
+		// Settings record from before journal was introduced is not needed anymore
+		storageErase(EFI_SETTINGS_RECORD_ID);
+	}
+#elif EFI_STORAGE_MFS == TRUE
 	/* In case of MFS:
 	 * do we need to have two copies?
 	 * do we need to protect it with CRC? */
@@ -258,7 +327,27 @@ static StorageStatus readOneConfigurationCopy(flashaddr_t address) {
  * in this method we read first copy of configuration in flash. if that first copy has CRC or other issues we read second copy.
  */
 static StorageStatus readConfiguration() {
-#if EFI_STORAGE_MFS == TRUE
+#if EFI_STORAGE_JOURNAL == TRUE
+	StorageStatus ret = settingsJournal.read();
+
+	if (ret == StorageStatus::Ok) {
+		return validatePersistentState();
+	}
+
+	if (ret != StorageStatus::NotFound) {
+		return ret;
+	}
+
+	// Settings could be stored as single record by older firmware, chunks will be written on next burn
+	efiPrintf("Reading settings as single record");
+	ret = storageRead(EFI_SETTINGS_RECORD_ID, (uint8_t *)&persistentState, sizeof(persistentState));
+
+	if (ret == StorageStatus::Ok) {
+		return validatePersistentState();
+	}
+
+	return ret;
+#elif EFI_STORAGE_MFS == TRUE
 	StorageStatus ret = storageRead(EFI_SETTINGS_RECORD_ID, (uint8_t *)&persistentState, sizeof(persistentState));
 
 	if (ret == StorageStatus::Ok) {
@@ -318,6 +407,7 @@ void readFromFlash() {
 
 	// we can only change the state after the CRC check
 	engineConfiguration->byFirmwareVersion = getRusEfiVersion();
+	invalidateConfigFieldCrc(*config);
 	engine->preCalculate();
 }
 
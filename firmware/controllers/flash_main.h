@@ -26,3 +26,7 @@ bool getNeedToWriteConfiguration();
 void writeToFlashIfPending();
 
 void settingsLtftRequestWriteToFlash();
+/**
+ * @return false if flash could not be written in background
+ */
+bool luaBytecodeRequestWriteToFlash();
@@ -31,7 +31,7 @@ void initSpeedometer() {
 
 	startSimplePwm(&speedoPwm,
 					"Speedometer",
-					&engine->scheduler,
+					getLowPriorityScheduler(),
 					&enginePins.speedoOut,
 					NAN, 0.5f);
 
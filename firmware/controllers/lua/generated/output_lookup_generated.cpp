@@ -825,6 +825,18 @@ float getOutputValueByName(const char *name) {
 // fuelCutReasonBlinker
 		case 1745186508:
 			return engine->outputChannels.fuelCutReasonBlinker;
+// cpuLoad
+		case -699845779:
+			return engine->outputChannels.cpuLoad;
+// isrLoad
+		case -1427124141:
+			return engine->outputChannels.isrLoad;
+// threadsMinFreeStack
+		case 690459660:
+			return engine->outputChannels.threadsMinFreeStack;
+// periodicDeadlineMisses
+		case 623765342:
+			return engine->outputChannels.periodicDeadlineMisses;
 // totalFuelCorrection
 #if EFI_ENGINE_CONTROL
 		case -1779658835:
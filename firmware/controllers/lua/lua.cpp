@@ -8,6 +8,9 @@
 #include "lua.hpp"
 #include "lua_hooks.h"
 #include "can_filter.h"
+#include "lua_bytecode_cache.h"
+#include "lua_heap.h"
+#include "lua_event_hooks.h"
 
 #define TAG "LUA "
 
@@ -37,93 +40,15 @@ static int totalRxCount = 0;
 static int rxTime;
 
 
-class Heap {
-public:
-	memory_heap_t m_heap;
-
-	size_t m_memoryUsed = 0;
-	size_t m_size;
-	char* m_buffer;
-
-	void* alloc(size_t n) {
-		return chHeapAlloc(&m_heap, n);
-	}
-
-	void free(void* obj) {
-		chHeapFree(obj);
-	}
-
-public:
-	template<size_t TSize>
-	Heap(char (&buffer)[TSize])
-	{
-		reinit(buffer, TSize);
-	}
-
-	void reinit(char *buffer, size_t size) {
-		criticalAssertVoid(m_memoryUsed == 0, "Too late to reinit Lua heap");
-
-		m_size = size;
-		m_buffer = buffer;
-
-		reset();
-	}
-
-	void* realloc(void* ptr, size_t osize, size_t nsize) {
-		if (nsize == 0) {
-			// requested size is zero, free if necessary and return nullptr
-			if (ptr) {
-				free(ptr);
-				m_memoryUsed -= osize;
-			}
-
-			return nullptr;
-		}
-
-		void *new_mem = alloc(nsize);
-
-		// Don't count the memory use if not allocated
-		if (new_mem) {
-			m_memoryUsed += nsize;
-		}
-
-		if (!ptr) {
-			// No old pointer passed in, simply return allocated block
-			return new_mem;
-		}
-
-		// An old pointer was passed in, copy the old data in, then free
-		if (new_mem != nullptr) {
-			memcpy(new_mem, ptr, chHeapGetSize(ptr) > nsize ? nsize : chHeapGetSize(ptr));
-			free(ptr);
-			m_memoryUsed -= osize;
-		}
-
-		return new_mem;
-	}
-
-	size_t size() const {
-		return m_size;
-	}
-
-	size_t used() const {
-		return m_memoryUsed;
-	}
-
-	// Use only in case of emergency - obliterates all heap objects and starts over
-	void reset() {
-		chHeapObjectInit(&m_heap, m_buffer, m_size);
-		m_memoryUsed = 0;
-	}
-};
-
-static Heap userHeap(luaUserHeap);
+static LuaHeap userHeap(luaUserHeap);
 
 static void printLuaMemoryInfo() {
 	auto heapSize = userHeap.size();
 	auto memoryUsed = userHeap.used();
 	float pct = 100.0f * memoryUsed / heapSize;
 	efiPrintf("Lua memory heap usage: %d / %d bytes = %.1f%%", memoryUsed, heapSize, pct);
+	efiPrintf("Lua memory heap peak %d bytes, largest free block %d bytes, fragmentation %.1f%%, failed allocations %d",
+		(int)userHeap.peakUsed(), (int)userHeap.largestFree(), userHeap.fragmentationPercent(), (int)userHeap.failedAllocations());
 }
 
 static void* myAlloc(void* /*ud*/, void* ptr, size_t osize, size_t nsize) {
@@ -210,10 +135,32 @@ static LuaHandle setupLuaState(lua_Alloc alloc) {
 	return ls;
 }
 
+/**
+ * Same as luaL_loadstring, but stored bytecode is preferred over compiling the source
+ */
+static int loadScriptChunk(LuaHandle& ls, const char* scriptStr) {
+#if EFI_LUA_BYTECODE_CACHE
+	if (luaLoadCachedBytecode(ls, scriptStr)) {
+		return 0;
+	}
+#endif // EFI_LUA_BYTECODE_CACHE
+
+	int status = luaL_loadstring(ls, scriptStr);
+
+#if EFI_LUA_BYTECODE_CACHE
+	if (0 == status) {
+		luaCacheBytecode(ls, scriptStr);
+	}
+#endif // EFI_LUA_BYTECODE_CACHE
+
+	return status;
+}
+
 static bool loadScript(LuaHandle& ls, const char* scriptStr) {
 	efiPrintf(TAG "loading script length: %lu...", efiStrlen(scriptStr));
 
-	if (0 != luaL_dostring(ls, scriptStr)) {
+	// same as luaL_dostring
+	if (0 != loadScriptChunk(ls, scriptStr) || 0 != lua_pcall(ls, 0, LUA_MULTRET, 0)) {
 	  withErrorLoading = true;
 		efiPrintf(TAG "ERROR loading script: %s", lua_tostring(ls, -1));
 		lua_pop(ls, 1);
@@ -308,6 +255,61 @@ static void resetLua() {
 
 static bool needsReset = false;
 
+// Tick taking more than this share of the tick period counts as budget overrun
+#define LUA_TICK_BUDGET_PERCENT 50
+// GC step is only started with at least this much time left before next tick
+#define LUA_GC_STEP_RESERVE_US 500
+#define LUA_GC_MAX_STEPS_PER_TICK 8
+
+static uint32_t budgetOverrunCount = 0;
+static uint32_t missedDeadlineCount = 0;
+static uint32_t slackGcStepCount = 0;
+
+/**
+ * Sleeps until next tick, running callbacks which come due in the meantime, see lua_event_hooks.h
+ */
+static void waitForNextTick(LuaHandle& ls, systime_t tickStart, systime_t nextTickStart) {
+	sysinterval_t tickPeriod = nextTickStart - tickStart;
+
+	while (!needsReset) {
+		dispatchLuaEventHooks(ls, getTimeNowNt());
+
+		sysinterval_t elapsed = chVTGetSystemTime() - tickStart;
+		if (elapsed >= tickPeriod) {
+			return;
+		}
+
+		sysinterval_t timeout = tickPeriod - elapsed;
+		efitick_t nextTimerNt;
+		if (getNextLuaTimerNt(nextTimerNt)) {
+			efidur_t untilTimerNt = nextTimerNt - getTimeNowNt();
+			sysinterval_t untilTimer = untilTimerNt > 0 ? TIME_US2I(NT2US(untilTimerNt)) : 0;
+			// zero would be TIME_IMMEDIATE, we want to actually let lower priority threads run
+			timeout = minI(timeout, maxI(1, untilTimer));
+		}
+
+		waitForLuaEvent(timeout);
+	}
+}
+
+/**
+ * Pays GC debt in the slack time after the tick, so that the collector
+ * does not have to kick in in the middle of the next tick
+ */
+static void stepGcInSlack(LuaHandle& ls, efitick_t deadlineNt) {
+	for (int i = 0; i < LUA_GC_MAX_STEPS_PER_TICK; i++) {
+		if (getTimeNowNt() + US2NT(LUA_GC_STEP_RESERVE_US) > deadlineNt) {
+			return;
+		}
+
+		slackGcStepCount++;
+		if (lua_gc(ls, LUA_GCSTEP, 0)) {
+			// cycle complete, nothing to do until next one
+			return;
+		}
+	}
+}
+
 // Each invocation of runOneLua will:
 // - create a new Lua instance
 // - read the script from config
@@ -332,6 +334,8 @@ static bool runOneLua(lua_Alloc alloc, const char* script) {
 		return false;
 	}
 
+	systime_t tickStart = chVTGetSystemTime();
+
 	while (!needsReset && !chThdShouldTerminateX()) {
 		efitick_t beforeNt = getTimeNowNt();
 #if EFI_CAN_SUPPORT
@@ -346,9 +350,29 @@ static bool runOneLua(lua_Alloc alloc, const char* script) {
 
 		invokeTick(ls);
 
-		engine->outputChannels.luaLastCycleDuration = (getTimeNowNt() - beforeNt);
+		efidur_t tickDurationNt = getTimeNowNt() - beforeNt;
+		engine->outputChannels.luaLastCycleDuration = tickDurationNt;
 		engine->outputChannels.luaInvocationCounter++;
-		chThdSleep(TIME_US2I(luaTickPeriodUs));
+
+		// setTickRate could have been invoked by this very tick
+		efidur_t periodNt = US2NT(luaTickPeriodUs);
+		if (tickDurationNt > periodNt * LUA_TICK_BUDGET_PERCENT / 100) {
+			budgetOverrunCount++;
+		}
+
+		stepGcInSlack(ls, beforeNt + periodNt);
+
+		// Same as PeriodicController: keep the rate, not the delay between ticks
+		systime_t period = TIME_US2I(luaTickPeriodUs);
+		systime_t nextTickStart = tickStart + period;
+		if (chVTGetSystemTime() - tickStart >= period) {
+			// Fell behind, no point running ticks back to back to catch up.
+			// Still sleep a little so that lower priority threads could run
+			missedDeadlineCount++;
+			nextTickStart = chVTGetSystemTime() + 1;
+		}
+		waitForNextTick(ls, tickStart, nextTickStart);
+		tickStart = nextTickStart;
 
 		engine->engineState.luaDigitalState0 = getAuxDigital(0);
 		engine->engineState.luaDigitalState1 = getAuxDigital(1);
@@ -437,6 +461,9 @@ void startLua() {
 	  efiPrintf("luaCycle %luus including luaRxTime %dus", NT2US(engine->outputChannels.luaLastCycleDuration),
 	    NT2US(rxTime));
 
+	  efiPrintf("tick period %dus, budget overruns %d, missed deadlines %d, GC steps in slack time %d",
+	    luaTickPeriodUs, (int)budgetOverrunCount, (int)missedDeadlineCount, (int)slackGcStepCount);
+
      printLuaMemoryInfo();
   });
 #endif
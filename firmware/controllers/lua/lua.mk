@@ -7,6 +7,9 @@ ALLCPPSRC += $(LUA_DIR)/lua.cpp \
 			 $(LUA_DIR)/lua_hooks_util.cpp \
 			 $(LUA_DIR)/script_impl.cpp \
 			 $(LUA_DIR)/lua_can_rx.cpp \
+			 $(LUA_DIR)/lua_bytecode_cache.cpp \
+			 $(LUA_DIR)/lua_heap.cpp \
+			 $(LUA_DIR)/lua_event_hooks.cpp \
 
 ifeq ($(EFI_LUA_LOOKUP), FALSE)
   ALLCPPSRC += $(LUA_DIR)/value_lookup_stubs.cpp \
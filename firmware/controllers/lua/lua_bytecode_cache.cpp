@@ -0,0 +1,140 @@
+/**
+ * @file	lua_bytecode_cache.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "lua_bytecode_cache.h"
+
+#if EFI_LUA && EFI_LUA_BYTECODE_CACHE
+
+#include "lua.hpp"
+#include "flash_main.h"
+#include "big_buffer.h"
+
+#define TAG "LUA "
+
+struct LuaBytecodeHeader {
+	uint32_t luaVersion;
+	// of the script source this bytecode was compiled from
+	uint32_t sourceCrc;
+	uint32_t size;
+	uint32_t crc;
+};
+
+// Written by Lua thread, stored and released by flash writer thread
+static LuaBytecodeHeader pendingHeader;
+static BigBufferHandle pendingBytecode;
+
+static uint32_t getSourceCrc(const char* script) {
+	return crc32(script, strlen(script));
+}
+
+static bool readHeader(LuaBytecodeHeader& header, const char* script) {
+	if (storageRead(EFI_LUA_BYTECODE_HEADER_RECORD_ID, (uint8_t*)&header, sizeof(header)) != StorageStatus::Ok) {
+		return false;
+	}
+
+	return header.luaVersion == LUA_VERSION_NUM && header.sourceCrc == getSourceCrc(script);
+}
+
+bool luaLoadCachedBytecode(lua_State* l, const char* script) {
+	LuaBytecodeHeader header;
+	if (!readHeader(header, script)) {
+		return false;
+	}
+
+	BigBufferHandle buffer = getBigBuffer(BigBufferUser::LuaBytecode, header.size);
+	if (!buffer) {
+		efiPrintf(TAG "no room for %lu bytes of bytecode", header.size);
+		return false;
+	}
+
+	if (storageRead(EFI_LUA_BYTECODE_RECORD_ID, buffer.get<uint8_t>(), header.size) != StorageStatus::Ok
+			|| crc32(buffer.get<uint8_t>(), header.size) != header.crc) {
+		efiPrintf(TAG "stored bytecode is damaged");
+		return false;
+	}
+
+	// "b": binary chunks only, the same call would happily take source otherwise
+	if (0 != luaL_loadbufferx(l, buffer.get<char>(), header.size, "script", "b")) {
+		efiPrintf(TAG "ERROR loading bytecode: %s", lua_tostring(l, -1));
+		lua_pop(l, 1);
+		return false;
+	}
+
+	efiPrintf(TAG "loaded %lu bytes of stored bytecode", header.size);
+	return true;
+}
+
+struct DumpState {
+	uint8_t* buffer;
+	size_t capacity;
+	size_t size;
+};
+
+static int writeBytecode(lua_State* /*l*/, const void* p, size_t size, void* ud) {
+	DumpState* state = reinterpret_cast<DumpState*>(ud);
+	if (state->buffer) {
+		if (state->size + size > state->capacity) {
+			return 1;
+		}
+		memcpy(state->buffer + state->size, p, size);
+	}
+	state->size += size;
+	return 0;
+}
+
+void luaCacheBytecode(lua_State* l, const char* script) {
+	if (pendingBytecode) {
+		// previous one is still on its way to flash
+		return;
+	}
+
+	// Partition is held until flash writer thread is done with it, so first pass only counts bytes
+	// and we take exactly what is needed. Debug info is kept, error messages should have line numbers
+	DumpState sizeOnly = { nullptr, 0, 0 };
+	lua_dump(l, writeBytecode, &sizeOnly, /*strip*/0);
+
+	BigBufferHandle buffer = getBigBuffer(BigBufferUser::LuaBytecode, sizeOnly.size);
+	if (!buffer) {
+		efiPrintf(TAG "no room for %d bytes of bytecode", (int)sizeOnly.size);
+		return;
+	}
+
+	DumpState state = { buffer.get<uint8_t>(), buffer.size(), 0 };
+	if (0 != lua_dump(l, writeBytecode, &state, /*strip*/0)) {
+		efiPrintf(TAG "bytecode does not fit into %d bytes", (int)buffer.size());
+		return;
+	}
+
+	pendingHeader.luaVersion = LUA_VERSION_NUM;
+	pendingHeader.sourceCrc = getSourceCrc(script);
+	pendingHeader.size = state.size;
+	pendingHeader.crc = crc32(state.buffer, state.size);
+	pendingBytecode = std::move(buffer);
+
+	if (luaBytecodeRequestWriteToFlash()) {
+		efiPrintf(TAG "storing %d bytes of bytecode", (int)state.size);
+	} else {
+		// flash could not be written while running on this MCU
+		pendingBytecode = {};
+	}
+}
+
+void luaStoreBytecode() {
+	if (!pendingBytecode) {
+		return;
+	}
+
+	// Header goes last: until it is written old header does not match new bytecode CRC
+	if (storageWrite(EFI_LUA_BYTECODE_RECORD_ID, pendingBytecode.get<uint8_t>(), pendingHeader.size) == StorageStatus::Ok) {
+		storageWrite(EFI_LUA_BYTECODE_HEADER_RECORD_ID, (const uint8_t*)&pendingHeader, sizeof(pendingHeader));
+	}
+
+	pendingBytecode = {};
+}
+
+#endif // EFI_LUA_BYTECODE_CACHE
@@ -0,0 +1,34 @@
+/**
+ * @file	lua_bytecode_cache.h
+ *
+ * Script compiled into Lua bytecode is kept in its own storage record, so that next start
+ * loads it directly instead of parsing and compiling the source on the ECU.
+ * Bytecode is only used if it was compiled from exactly the current script source.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "storage.h"
+
+// Needs MFS for records and flash writer thread to store them while running
+#ifndef EFI_LUA_BYTECODE_CACHE
+#define EFI_LUA_BYTECODE_CACHE ((EFI_STORAGE_MFS == TRUE) && (EFI_FLASH_WRITE_THREAD == TRUE))
+#endif
+
+struct lua_State;
+
+/**
+ * Pushes main chunk of the script just like luaL_loadstring would
+ * @return false if there is no usable bytecode, nothing is pushed in that case
+ */
+bool luaLoadCachedBytecode(lua_State* l, const char* script);
+/**
+ * Dumps the main chunk on top of the stack and schedules write to storage, stack is not modified
+ */
+void luaCacheBytecode(lua_State* l, const char* script);
+/**
+ * Invoked by flash writer thread
+ */
+void luaStoreBytecode();
@@ -0,0 +1,222 @@
+/**
+ * @file	lua_event_hooks.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#if EFI_LUA
+
+#include "rusefi_lua.h"
+#include "lua_event_hooks.h"
+
+#define TAG "LUA "
+
+#define LUA_MAX_TIMERS 8
+#define LUA_MAX_SENSOR_HOOKS 8
+// same limit as setTickRate
+#define LUA_MIN_TIMER_PERIOD_MS 5
+
+struct LuaTimer {
+	int callback;
+	efidur_t periodNt;
+	efitick_t nextNt;
+};
+
+struct LuaSensorHook {
+	int callback;
+	SensorType type;
+	float threshold;
+	// last reported
+	float value;
+	bool isValid;
+};
+
+static LuaTimer timers[LUA_MAX_TIMERS];
+static size_t timerCount = 0;
+
+static LuaSensorHook sensorHooks[LUA_MAX_SENSOR_HOOKS];
+static size_t sensorHookCount = 0;
+
+static int engineCycleCallback = LUA_NOREF;
+static volatile bool hasEngineCycleCallback = false;
+static uint32_t lastEngineCycle = 0;
+
+static int getCallback(lua_State* l, int index) {
+	luaL_checktype(l, index, LUA_TFUNCTION);
+	lua_pushvalue(l, index);
+	return luaL_ref(l, LUA_REGISTRYINDEX);
+}
+
+static int lua_every(lua_State* l) {
+	int periodMs = luaL_checkinteger(l, 1);
+	if (timerCount == LUA_MAX_TIMERS) {
+		return luaL_error(l, "Too many timers, %d max", LUA_MAX_TIMERS);
+	}
+
+	LuaTimer& timer = timers[timerCount];
+	timer.callback = getCallback(l, 2);
+	timer.periodNt = MS2NT(maxI(LUA_MIN_TIMER_PERIOD_MS, periodMs));
+	timer.nextNt = getTimeNowNt() + timer.periodNt;
+	timerCount++;
+
+	return 0;
+}
+
+static int lua_onEngineCycle(lua_State* l) {
+	engineCycleCallback = getCallback(l, 1);
+	lastEngineCycle = getRevolutionCounter();
+	hasEngineCycleCallback = true;
+
+	return 0;
+}
+
+static int lua_onSensorChange(lua_State* l) {
+	auto sensorName = luaL_checklstring(l, 1, nullptr);
+	SensorType type = findSensorTypeByName(sensorName);
+	if (type == SensorType::Invalid) {
+		return luaL_error(l, "Invalid sensor type: %s", sensorName);
+	}
+	if (sensorHookCount == LUA_MAX_SENSOR_HOOKS) {
+		return luaL_error(l, "Too many sensor hooks, %d max", LUA_MAX_SENSOR_HOOKS);
+	}
+
+	LuaSensorHook& hook = sensorHooks[sensorHookCount];
+	hook.type = type;
+	hook.threshold = luaL_checknumber(l, 2);
+	hook.callback = getCallback(l, 3);
+	// first valid value is reported right away
+	hook.isValid = false;
+	hook.value = 0;
+	sensorHookCount++;
+
+	return 0;
+}
+
+void configureLuaEventHooks(lua_State* l) {
+	// callbacks were references into previous Lua state
+	timerCount = 0;
+	sensorHookCount = 0;
+	hasEngineCycleCallback = false;
+	engineCycleCallback = LUA_NOREF;
+
+	lua_register(l, "every", lua_every);
+	lua_register(l, "onEngineCycle", lua_onEngineCycle);
+	lua_register(l, "onSensorChange", lua_onSensorChange);
+}
+
+static void invokeCallback(lua_State* l, int argumentCount) {
+	if (0 != lua_pcall(l, argumentCount, 0, 0)) {
+		efiPrintf(TAG "callback error %s", lua_tostring(l, -1));
+	}
+
+	lua_settop(l, 0);
+}
+
+static void dispatchTimers(lua_State* l, efitick_t nowNt) {
+	// callbacks could add more timers, these wait till next time
+	size_t count = timerCount;
+	for (size_t i = 0; i < count; i++) {
+		LuaTimer& timer = timers[i];
+		if (nowNt < timer.nextNt) {
+			continue;
+		}
+
+		// keep the rate, but do not try to catch up after a long delay
+		timer.nextNt += timer.periodNt;
+		if (timer.nextNt <= nowNt) {
+			timer.nextNt = nowNt + timer.periodNt;
+		}
+
+		lua_rawgeti(l, LUA_REGISTRYINDEX, timer.callback);
+		invokeCallback(l, 0);
+	}
+}
+
+static void dispatchEngineCycle(lua_State* l) {
+	if (!hasEngineCycleCallback) {
+		return;
+	}
+
+	uint32_t engineCycle = getRevolutionCounter();
+	if (engineCycle == lastEngineCycle) {
+		return;
+	}
+	uint32_t elapsed = engineCycle - lastEngineCycle;
+	lastEngineCycle = engineCycle;
+
+	lua_rawgeti(l, LUA_REGISTRYINDEX, engineCycleCallback);
+	lua_pushinteger(l, elapsed);
+	invokeCallback(l, 1);
+}
+
+static void dispatchSensorHooks(lua_State* l) {
+	size_t count = sensorHookCount;
+	for (size_t i = 0; i < count; i++) {
+		LuaSensorHook& hook = sensorHooks[i];
+		auto result = Sensor::get(hook.type);
+
+		bool isChanged = result.Valid != hook.isValid
+			|| (result.Valid && absF(result.Value - hook.value) >= hook.threshold);
+		if (!isChanged) {
+			continue;
+		}
+
+		hook.isValid = result.Valid;
+		hook.value = result.Value;
+
+		lua_rawgeti(l, LUA_REGISTRYINDEX, hook.callback);
+		if (result.Valid) {
+			lua_pushnumber(l, result.Value);
+		} else {
+			lua_pushnil(l);
+		}
+		invokeCallback(l, 1);
+	}
+}
+
+void dispatchLuaEventHooks(lua_State* l, efitick_t nowNt) {
+	dispatchTimers(l, nowNt);
+	dispatchEngineCycle(l);
+	dispatchSensorHooks(l);
+}
+
+bool getNextLuaTimerNt(efitick_t& nextNt) {
+	for (size_t i = 0; i < timerCount; i++) {
+		if (i == 0 || timers[i].nextNt < nextNt) {
+			nextNt = timers[i].nextNt;
+		}
+	}
+
+	return timerCount != 0;
+}
+
+#if EFI_PROD_CODE || EFI_SIMULATOR
+static BSEMAPHORE_DECL(luaWakeup, true);
+
+void onLuaEngineCycle() {
+	if (!hasEngineCycleCallback) {
+		return;
+	}
+
+	// trigger handling could be in ISR or in thread context
+	syssts_t sts = chSysGetStatusAndLockX();
+	chBSemSignalI(&luaWakeup);
+	if (!port_is_isr_context()) {
+		chSchRescheduleS();
+	}
+	chSysRestoreStatusX(sts);
+}
+
+void waitForLuaEvent(sysinterval_t timeout) {
+	chBSemWaitTimeout(&luaWakeup, timeout);
+}
+#else
+
+// unit tests invoke dispatchLuaEventHooks directly
+void onLuaEngineCycle() { }
+
+#endif // EFI_PROD_CODE || EFI_SIMULATOR
+
+#endif // EFI_LUA
@@ -0,0 +1,41 @@
+/**
+ * @file	lua_event_hooks.h
+ *
+ * Script callbacks invoked at their own rate, dispatched by the Lua thread between ticks:
+ *   every(periodMs, fn)                        fn()
+ *   onEngineCycle(fn)                          fn(cyclesSinceLastCall)
+ *   onSensorChange(sensorName, threshold, fn)  fn(value), nil once sensor is invalid
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+struct lua_State;
+
+/**
+ * Registers the functions above, forgets callbacks of previous Lua state
+ */
+void configureLuaEventHooks(lua_State* l);
+
+/**
+ * Invokes callbacks which are due, Lua thread only
+ */
+void dispatchLuaEventHooks(lua_State* l, efitick_t nowNt);
+
+/**
+ * @return false if there are no timers
+ */
+bool getNextLuaTimerNt(efitick_t& nextNt);
+
+/**
+ * Engine cycle notification from trigger handling, wakes up Lua thread if script has asked for it
+ */
+void onLuaEngineCycle();
+
+#if EFI_PROD_CODE || EFI_SIMULATOR
+/**
+ * Sleeps until timeout or until there is an event for Lua thread
+ */
+void waitForLuaEvent(sysinterval_t timeout);
+#endif
@@ -0,0 +1,323 @@
+/**
+ * @file	lua_heap.cpp
+ *
+ * Boundary tag allocator, see lua_heap.h
+ *
+ * Every block starts with a header which knows sizes of this and of the physically previous block,
+ * so both neighbours are found in constant time. Free blocks keep their list links in the payload.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "lua_heap.h"
+
+// Lua does not need more than 8 byte alignment, see LUAI_MAXALIGN
+#define LUA_HEAP_ALIGNMENT 8
+
+static constexpr uint32_t noBlock = UINT32_MAX;
+static constexpr uint32_t usedFlag = 1;
+
+struct LuaHeap::Block {
+	// whole block including this header, usedFlag is set while allocated
+	uint32_t sizeAndFlag;
+	// zero for the first block
+	uint32_t prevSize;
+
+	// free blocks only, offsets of neighbours in the same bin
+	uint32_t nextFree;
+	uint32_t prevFree;
+
+	uint32_t size() const {
+		return sizeAndFlag & ~usedFlag;
+	}
+
+	bool isUsed() const {
+		return sizeAndFlag & usedFlag;
+	}
+
+	void* payload() {
+		return reinterpret_cast<char*>(this) + headerSize;
+	}
+
+	static constexpr uint32_t headerSize = 2 * sizeof(uint32_t);
+};
+
+// a free block has to hold its list links
+static constexpr uint32_t minBlockSize = 4 * sizeof(uint32_t);
+static_assert(minBlockSize % LUA_HEAP_ALIGNMENT == 0);
+
+// block sizes up to this one have exact size classes
+static constexpr uint32_t smallBlockLimit = 128;
+static constexpr size_t smallBinCount = (smallBlockLimit - minBlockSize) / LUA_HEAP_ALIGNMENT + 1;
+
+static uint32_t roundUp(size_t size) {
+	return (size + LUA_HEAP_ALIGNMENT - 1) & ~(LUA_HEAP_ALIGNMENT - 1);
+}
+
+static uint32_t log2Floor(uint32_t value) {
+	return 31 - __builtin_clz(value);
+}
+
+/**
+ * Bins are ordered: any block in a bin is bigger than any block in a lower bin
+ */
+static size_t binIndex(uint32_t blockSize, size_t binCount) {
+	if (blockSize <= smallBlockLimit) {
+		return (blockSize - minBlockSize) / LUA_HEAP_ALIGNMENT;
+	}
+
+	// smallBlockLimit + 1 up to 2 * smallBlockLimit - 1 is the first one
+	size_t index = smallBinCount + log2Floor(blockSize) - log2Floor(smallBlockLimit);
+	return index < binCount ? index : binCount - 1;
+}
+
+LuaHeap::Block* LuaHeap::blockAt(uint32_t offset) const {
+	return reinterpret_cast<Block*>(m_buffer + offset);
+}
+
+uint32_t LuaHeap::offsetOf(const Block* block) const {
+	return reinterpret_cast<const char*>(block) - m_buffer;
+}
+
+LuaHeap::Block* LuaHeap::nextBlock(const Block* block) const {
+	uint32_t offset = offsetOf(block) + block->size();
+	return offset < m_size ? blockAt(offset) : nullptr;
+}
+
+void LuaHeap::reinit(char *buffer, size_t size) {
+	criticalAssertVoid(m_used == 0, "Too late to reinit Lua heap");
+
+	uintptr_t start = reinterpret_cast<uintptr_t>(buffer);
+	size_t padding = (LUA_HEAP_ALIGNMENT - start % LUA_HEAP_ALIGNMENT) % LUA_HEAP_ALIGNMENT;
+	m_buffer = buffer + padding;
+	m_size = size > padding ? (size - padding) & ~(LUA_HEAP_ALIGNMENT - 1) : 0;
+
+	reset();
+}
+
+void LuaHeap::reset() {
+	static_assert(sizeof(Block) == minBlockSize);
+
+	for (size_t i = 0; i < binCount; i++) {
+		m_bins[i] = noBlock;
+	}
+	m_nonEmptyBins = 0;
+	m_used = 0;
+	m_peakUsed = 0;
+	m_failedAllocations = 0;
+
+	if (m_size < minBlockSize) {
+		return;
+	}
+
+	Block* whole = blockAt(0);
+	whole->sizeAndFlag = m_size;
+	whole->prevSize = 0;
+	insertFree(whole);
+}
+
+void LuaHeap::insertFree(Block* block) {
+	size_t bin = binIndex(block->size(), binCount);
+	uint32_t offset = offsetOf(block);
+
+	block->sizeAndFlag = block->size();
+	block->prevFree = noBlock;
+	block->nextFree = m_bins[bin];
+	if (block->nextFree != noBlock) {
+		blockAt(block->nextFree)->prevFree = offset;
+	}
+	m_bins[bin] = offset;
+	m_nonEmptyBins |= 1u << bin;
+}
+
+void LuaHeap::removeFree(Block* block) {
+	size_t bin = binIndex(block->size(), binCount);
+
+	if (block->prevFree != noBlock) {
+		blockAt(block->prevFree)->nextFree = block->nextFree;
+	} else {
+		m_bins[bin] = block->nextFree;
+		if (block->nextFree == noBlock) {
+			m_nonEmptyBins &= ~(1u << bin);
+		}
+	}
+	if (block->nextFree != noBlock) {
+		blockAt(block->nextFree)->prevFree = block->prevFree;
+	}
+
+	block->sizeAndFlag |= usedFlag;
+}
+
+LuaHeap::Block* LuaHeap::takeFree(uint32_t blockSize) {
+	size_t bin = binIndex(blockSize, binCount);
+
+	// small bins are exact size, larger ones need first fit
+	for (uint32_t offset = m_bins[bin]; offset != noBlock; offset = blockAt(offset)->nextFree) {
+		Block* block = blockAt(offset);
+		if (block->size() >= blockSize) {
+			removeFree(block);
+			return block;
+		}
+	}
+
+	// anything from the next non-empty bin is big enough
+	uint32_t biggerBins = bin + 1 < binCount ? m_nonEmptyBins & ~((2u << bin) - 1) : 0;
+	if (biggerBins == 0) {
+		return nullptr;
+	}
+
+	Block* block = blockAt(m_bins[__builtin_ctz(biggerBins)]);
+	removeFree(block);
+	return block;
+}
+
+void LuaHeap::trim(Block* block, uint32_t blockSize) {
+	uint32_t tailSize = block->size() - blockSize;
+	if (tailSize < minBlockSize) {
+		return;
+	}
+
+	block->sizeAndFlag = blockSize | (block->sizeAndFlag & usedFlag);
+
+	Block* tail = nextBlock(block);
+	tail->sizeAndFlag = tailSize | usedFlag;
+	tail->prevSize = blockSize;
+
+	Block* afterTail = nextBlock(tail);
+	if (afterTail) {
+		afterTail->prevSize = tailSize;
+	}
+
+	// could be merged with next free block
+	release(tail);
+}
+
+void LuaHeap::release(Block* block) {
+	uint32_t size = block->size();
+
+	Block* next = nextBlock(block);
+	if (next && !next->isUsed()) {
+		removeFree(next);
+		size += next->size();
+	}
+
+	if (block->prevSize != 0) {
+		Block* prev = blockAt(offsetOf(block) - block->prevSize);
+		if (!prev->isUsed()) {
+			removeFree(prev);
+			size += prev->size();
+			block = prev;
+		}
+	}
+
+	block->sizeAndFlag = size;
+	Block* after = nextBlock(block);
+	if (after) {
+		after->prevSize = size;
+	}
+
+	insertFree(block);
+}
+
+void LuaHeap::addUsed(uint32_t blockSize) {
+	m_used += blockSize;
+	if (m_used > m_peakUsed) {
+		m_peakUsed = m_used;
+	}
+}
+
+void* LuaHeap::realloc(void* ptr, size_t /*osize*/, size_t nsize) {
+	Block* block = ptr ? reinterpret_cast<Block*>(static_cast<char*>(ptr) - Block::headerSize) : nullptr;
+
+	if (nsize == 0) {
+		// requested size is zero, free if necessary and return nullptr
+		if (block) {
+			m_used -= block->size();
+			release(block);
+		}
+
+		return nullptr;
+	}
+
+	if (nsize > m_size) {
+		m_failedAllocations++;
+		return nullptr;
+	}
+
+	uint32_t blockSize = roundUp(nsize + Block::headerSize);
+	if (blockSize < minBlockSize) {
+		blockSize = minBlockSize;
+	}
+
+	if (block) {
+		uint32_t oldSize = block->size();
+
+		// Shrink in place
+		if (blockSize <= oldSize) {
+			trim(block, blockSize);
+			m_used -= oldSize - block->size();
+			return ptr;
+		}
+
+		// Grow in place into the following free block
+		Block* next = nextBlock(block);
+		if (next && !next->isUsed() && oldSize + next->size() >= blockSize) {
+			removeFree(next);
+			block->sizeAndFlag = (oldSize + next->size()) | usedFlag;
+			Block* after = nextBlock(block);
+			if (after) {
+				after->prevSize = block->size();
+			}
+
+			trim(block, blockSize);
+			addUsed(block->size() - oldSize);
+			return ptr;
+		}
+	}
+
+	Block* fresh = takeFree(blockSize);
+	if (!fresh) {
+		m_failedAllocations++;
+		return nullptr;
+	}
+	trim(fresh, blockSize);
+	addUsed(fresh->size());
+
+	if (block) {
+		// An old pointer was passed in, copy the old data in, then free
+		memcpy(fresh->payload(), ptr, block->size() - Block::headerSize);
+		m_used -= block->size();
+		release(block);
+	}
+
+	return fresh->payload();
+}
+
+size_t LuaHeap::largestFree() const {
+	if (m_nonEmptyBins == 0) {
+		return 0;
+	}
+
+	size_t largest = 0;
+	size_t bin = log2Floor(m_nonEmptyBins);
+	for (uint32_t offset = m_bins[bin]; offset != noBlock; offset = blockAt(offset)->nextFree) {
+		size_t size = blockAt(offset)->size();
+		if (size > largest) {
+			largest = size;
+		}
+	}
+
+	return largest - Block::headerSize;
+}
+
+float LuaHeap::fragmentationPercent() const {
+	size_t freeBytes = m_size - m_used;
+	if (freeBytes == 0) {
+		return 0;
+	}
+
+	// largestFree() is payload, free bytes include headers
+	return 100.0f * (1 - (float)(largestFree() + Block::headerSize) / freeBytes);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file	lua_heap.h
+ *
+ * Allocator for the Lua heap. Free blocks are kept in segregated lists: exact size classes for
+ * the small objects Lua allocates most (strings, closures, table nodes) and power of two bins
+ * for larger ones. Neighbouring free blocks are merged right away and realloc grows or shrinks
+ * in place whenever possible, so that long running scripts do not fragment a small heap.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class LuaHeap {
+public:
+	template<size_t TSize>
+	LuaHeap(char (&buffer)[TSize])
+	{
+		reinit(buffer, TSize);
+	}
+
+	LuaHeap(char *buffer, size_t size) {
+		reinit(buffer, size);
+	}
+
+	void reinit(char *buffer, size_t size);
+
+	// Same contract as lua_Alloc: nsize zero frees, nullptr ptr allocates, nullptr result leaves ptr intact
+	void* realloc(void* ptr, size_t osize, size_t nsize);
+
+	size_t size() const {
+		return m_size;
+	}
+
+	// bytes in allocated blocks, including block headers
+	size_t used() const {
+		return m_used;
+	}
+
+	size_t peakUsed() const {
+		return m_peakUsed;
+	}
+
+	uint32_t failedAllocations() const {
+		return m_failedAllocations;
+	}
+
+	size_t largestFree() const;
+	// zero while all free memory is one block, approaches 100 as it is scattered into small pieces
+	float fragmentationPercent() const;
+
+	// Use only in case of emergency - obliterates all heap objects and starts over
+	void reset();
+
+private:
+	struct Block;
+
+	Block* blockAt(uint32_t offset) const;
+	uint32_t offsetOf(const Block* block) const;
+	Block* nextBlock(const Block* block) const;
+
+	void insertFree(Block* block);
+	void removeFree(Block* block);
+	Block* takeFree(uint32_t blockSize);
+	// splits off the tail beyond blockSize as a free block, if it is big enough to be one
+	void trim(Block* block, uint32_t blockSize);
+	void release(Block* block);
+
+	void addUsed(uint32_t blockSize);
+
+	static constexpr size_t binCount = 32;
+	// offset of the first free block in each bin
+	uint32_t m_bins[binCount];
+	// bit set for each non-empty bin
+	uint32_t m_nonEmptyBins = 0;
+
+	char* m_buffer = nullptr;
+	size_t m_size = 0;
+
+	size_t m_used = 0;
+	size_t m_peakUsed = 0;
+	uint32_t m_failedAllocations = 0;
+};
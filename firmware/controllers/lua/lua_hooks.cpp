@@ -10,6 +10,7 @@
 #include "value_lookup.h"
 #include "can_filter.h"
 #include "tunerstudio.h"
+#include "ts_page_crc.h"
 #include "lua_pid.h"
 #include "start_stop.h"
 
@@ -31,6 +32,7 @@
 #define LUAAA_WITHOUT_CPP_STDLIB
 #include "luaaa.hpp"
 #include "lua_hooks_util.h"
+#include "lua_event_hooks.h"
 using namespace luaaa;
 
 #include "script_impl.h"
@@ -278,7 +280,7 @@ void startPwm(int index, float freq, float duty) {
   brain_pin_e pwmPin = engineConfiguration->luaOutputPins[index];
 
 	startSimplePwmExt(
-		&pwms[index], "lua", &engine->scheduler,
+		&pwms[index], "lua", getLowPriorityScheduler(),
 		pwmPin, &enginePins.luaOutputPins[index],
 		freq, duty
 	);
@@ -680,6 +682,7 @@ void configureRusefiLuaHooks(lua_State* lState) {
 #endif
 
 	configureRusefiLuaUtilHooks(lState);
+	configureLuaEventHooks(lState);
 
 	lua_register(lState, "readPin", lua_readpin);
 #if EFI_PROD_CODE && EFI_SHAFT_POSITION_INPUT
@@ -968,9 +971,14 @@ void configureRusefiLuaHooks(lua_State* lState) {
 		auto propertyName = luaL_checklstring(l, 1, nullptr);
 		auto value = luaL_checknumber(l, 2);
 		auto incrementVersion = lua_toboolean(l, 3);
+		float previousValue = getConfigValueByName(propertyName);
 		bool isGoodName = setConfigValueByName(propertyName, value);
 		if (isGoodName) {
 		    efiPrintf("LUA: applying [%s][%f]", propertyName, value);
+		    // scripts tend to set the same value over and over
+		    if (getConfigValueByName(propertyName) != previousValue) {
+		        invalidateConfigValueByNameCrc();
+		    }
 		} else {
 		    efiPrintf("LUA: invalid calibration key [%s]", propertyName);
 		}
@@ -63,6 +63,122 @@ StorageStatus mfsStorageRead(int id, uint8_t *ptr, size_t size) {
 	return StorageStatus::Ok;
 }
 
+StorageStatus mfsStorageErase(int id) {
+	mfs_error_t err = mfsEraseRecord(&mfsd, id);
+
+	// Not found is fine - nothing to erase
+	return ((err >= MFS_NO_ERROR) || (err == MFS_ERR_NOT_FOUND)) ? StorageStatus::Ok : StorageStatus::Failed;
+}
+
+#if EFI_STORAGE_JOURNAL == TRUE
+static size_t getChunkSize(size_t index, size_t size, size_t chunkSize) {
+	size_t offset = index * chunkSize;
+	return minI(chunkSize, size - offset);
+}
+
+StorageStatus mfsStorageWriteChunks(int firstId, const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask) {
+	size_t chunkCount = (size + chunkSize - 1) / chunkSize;
+
+	size_t transactionSize = 0;
+	int dirtyCount = 0;
+	for (size_t i = 0; i < chunkCount; i++) {
+		if (dirtyMask & (1 << i)) {
+			transactionSize += sizeof(mfs_data_header_t) + getChunkSize(i, size, chunkSize);
+			dirtyCount++;
+		}
+	}
+
+	if (dirtyCount == 0) {
+		efiPrintf("Storage ID %d..%d: nothing changed", firstId, firstId + chunkCount - 1);
+		return StorageStatus::Ok;
+	}
+
+	efiPrintf("Writing storage ID %d..%d ... %d of %d chunks, %d bytes", firstId, firstId + chunkCount - 1,
+		dirtyCount, chunkCount, transactionSize);
+	efitick_t startNt = getTimeNowNt();
+
+	// All chunks go in one transaction: after power loss we get either old or new set of chunks, never a mix
+	mfs_error_t err = mfsStartTransaction(&mfsd, transactionSize);
+
+	for (size_t i = 0; (i < chunkCount) && (err >= MFS_NO_ERROR); i++) {
+		if (dirtyMask & (1 << i)) {
+			err = mfsWriteRecord(&mfsd, firstId + i, getChunkSize(i, size, chunkSize), ptr + i * chunkSize);
+		}
+	}
+
+	if (err >= MFS_NO_ERROR) {
+		err = mfsCommitTransaction(&mfsd);
+	} else {
+		mfsRollbackTransaction(&mfsd);
+	}
+
+	efitick_t endNt = getTimeNowNt();
+	int elapsed_Ms = US2MS(NT2US(endNt - startNt));
+
+	if (err >= MFS_NO_ERROR) {
+		efiPrintf("Write done with no errors after %d mS MFS status %d", elapsed_Ms, err);
+	} else {
+		efiPrintf("Write FAILED after %d with MFS status %d", elapsed_Ms, err);
+
+		return StorageStatus::Failed;
+	}
+
+	return StorageStatus::Ok;
+}
+
+StorageStatus mfsStorageReadChunks(int firstId, uint8_t *ptr, size_t size, size_t chunkSize) {
+	size_t chunkCount = (size + chunkSize - 1) / chunkSize;
+
+	efiPrintf("Reading storage ID %d..%d ... %d bytes", firstId, firstId + chunkCount - 1, size);
+
+	for (size_t i = 0; i < chunkCount; i++) {
+		size_t expected_size = getChunkSize(i, size, chunkSize);
+		size_t readed_size = expected_size;
+		mfs_error_t err = mfsReadRecord(&mfsd, firstId + i, &readed_size, ptr + i * chunkSize);
+
+		if (err < MFS_NO_ERROR) {
+			efiPrintf("Read of ID %d FAILED with MFS status %d", firstId + i, err);
+			return StorageStatus::NotFound;
+		}
+
+		if (readed_size != expected_size) {
+			efiPrintf("Incorrect size of ID %d expected %d readed %d", firstId + i, expected_size, readed_size);
+			return StorageStatus::IncompatibleVersion;
+		}
+	}
+
+	efiPrintf("Reading done with no errors");
+	return StorageStatus::Ok;
+}
+#endif // EFI_STORAGE_JOURNAL
+
+/**
+ * MFS packs the bank when there is no room left for next write, this takes seconds.
+ * Do it in advance from low priority thread so burn itself stays fast.
+ */
+void mfsStorageCompactIfNeeded() {
+	if (mfsd.state != MFS_READY) {
+		return;
+	}
+
+	size_t bankSize = mfsd.config->bank_size;
+	size_t freeSpace = bankSize - mfsd.next_offset;
+	size_t staleSpace = mfsd.next_offset - mfsd.used_space;
+
+	// less than quarter of bank is left and packing will free at least as much
+	if ((freeSpace > bankSize / 4) || (staleSpace < bankSize / 4)) {
+		return;
+	}
+
+	efitick_t startNt = getTimeNowNt();
+
+	mfs_error_t err = mfsPerformGarbageCollection(&mfsd);
+
+	efitick_t endNt = getTimeNowNt();
+	int elapsed_Ms = US2MS(NT2US(endNt - startNt));
+	efiPrintf("MFS compaction done %d mS err %d, %d bytes free", elapsed_Ms, err, bankSize - mfsd.next_offset);
+}
+
 StorageStatus mfsStorageFormat()
 {
 	efitick_t startNt = getTimeNowNt();
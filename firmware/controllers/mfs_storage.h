@@ -12,6 +12,11 @@
 
 StorageStatus mfsStorageWrite(int id, const uint8_t *ptr, size_t size);
 StorageStatus mfsStorageRead(int id, uint8_t *ptr, size_t size);
+StorageStatus mfsStorageErase(int id);
 StorageStatus mfsStorageFormat();
 
+StorageStatus mfsStorageWriteChunks(int firstId, const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask);
+StorageStatus mfsStorageReadChunks(int firstId, uint8_t *ptr, size_t size, size_t chunkSize);
+void mfsStorageCompactIfNeeded();
+
 void initStorageMfs();
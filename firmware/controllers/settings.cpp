@@ -17,6 +17,7 @@
 #include "alternator_controller.h"
 #include "trigger_emulator_algo.h"
 #include "value_lookup.h"
+#include "ts_page_crc.h"
 #if EFI_RTC
 #include "rtc_helper.h"
 #endif // EFI_RTC
@@ -157,6 +158,7 @@ static void setDebugMode(int value) {
 
 static void setWholeTimingMap(float value) {
 	setTable(config->ignitionTable, value);
+	invalidateConfigFieldCrc(config->ignitionTable);
 }
 
 static void setWholeTimingMapCmd(float value) {
@@ -193,6 +195,7 @@ static void setIgnitionPin(const char *indexStr, const char *pinName) {
 	}
 	efiPrintf("setting ignition pin[%d] to %s please save&restart", index, hwPortname(pin));
 	engineConfiguration->ignitionPins[index] = pin;
+	invalidateConfigFieldCrc(engineConfiguration->ignitionPins[index]);
 	incrementGlobalConfigurationVersion();
 }
 
@@ -235,6 +238,7 @@ static void setIndividualPin(const char *pinName, brain_pin_e *targetPin, const
 	}
 	efiPrintf("setting %s pin to %s please save&restart", name, hwPortname(pin));
 	*targetPin = pin;
+	invalidateConfigFieldCrc(*targetPin);
 	incrementGlobalConfigurationVersion();
 }
 
@@ -268,6 +272,7 @@ static void setTriggerInputPin(const char *indexStr, const char *pinName) {
 	}
 	efiPrintf("setting trigger pin[%d] to %s please save&restart", index, hwPortname(pin));
 	engineConfiguration->triggerInputPins[index] = pin;
+	invalidateConfigFieldCrc(engineConfiguration->triggerInputPins[index]);
 	incrementGlobalConfigurationVersion();
 }
 
@@ -281,6 +286,7 @@ static void setTriggerSimulatorPin(const char *indexStr, const char *pinName) {
 	}
 	efiPrintf("setting trigger simulator pin[%d] to %s please save&restart", index, hwPortname(pin));
 	engineConfiguration->triggerSimulatorPins[index] = pin;
+	invalidateConfigFieldCrc(engineConfiguration->triggerSimulatorPins[index]);
 	incrementGlobalConfigurationVersion();
 }
 
@@ -319,6 +325,7 @@ static void setAnalogInputPin(const char *sensorStr, const char *pinName) {
 		engineConfiguration->tps2_1AdcChannel = channel;
 		efiPrintf("setting TPS2 to %s/%d", pinName, channel);
 	}
+	invalidateConfigFieldCrc(*engineConfiguration);
 	incrementGlobalConfigurationVersion();
 }
 #endif // HAL_USE_ADC
@@ -334,6 +341,7 @@ static void setLogicInputPin(const char *indexStr, const char *pinName) {
 	}
 	efiPrintf("setting logic input pin[%d] to %s please save&restart", index, hwPortname(pin));
 	engineConfiguration->logicAnalyzerPins[index] = pin;
+	invalidateConfigFieldCrc(engineConfiguration->logicAnalyzerPins[index]);
 	incrementGlobalConfigurationVersion();
 }
 
@@ -354,6 +362,8 @@ static void setSpiMode(int index, bool mode) {
 		efiPrintf("invalid spi index %d", index);
 		return;
 	}
+	// bit fields
+	invalidateConfigFieldCrc(*engineConfiguration);
 	printSpiState();
 }
 
@@ -433,6 +443,8 @@ static void enableOrDisable(const char *param, bool isEnabled) {
 		efiPrintf("unexpected [%s]", param);
 		return; // well, MISRA would not like this 'return' here :(
 	}
+	// bit fields
+	invalidateConfigFieldCrc(*engineConfiguration);
 	efiPrintf("[%s] %s", param, isEnabled ? "enabled" : "disabled");
 }
 
@@ -488,10 +500,12 @@ static void getValue(const char *paramStr) {
 
 static void setScriptCurve1Value(float value) {
 	setLinearCurve(config->scriptCurve1, value, value, 1);
+	invalidateConfigFieldCrc(config->scriptCurve1);
 }
 
 static void setScriptCurve2Value(float value) {
 	setLinearCurve(config->scriptCurve2, value, value, 1);
+	invalidateConfigFieldCrc(config->scriptCurve2);
 }
 
 struct command_i_s {
@@ -552,7 +566,7 @@ const command_i_s commandsI[] = {
 		//		{"", },
 };
 
-static void setValue(const char *paramStr, const char *valueStr) {
+static void applyValue(const char *paramStr, const char *valueStr) {
 	float valueF = atoff(valueStr);
 	int valueI = atoi(valueStr);
 
@@ -579,6 +593,8 @@ static void setValue(const char *paramStr, const char *valueStr) {
 		engineConfiguration->warningPeriod = valueI;
 	} else if (strEqualCaseInsensitive(paramStr, "dwell")) {
 		setConstantDwell(valueF);
+		invalidateConfigFieldCrc(config->sparkDwellRpmBins);
+		invalidateConfigFieldCrc(config->sparkDwellValues);
 	} else if (strEqualCaseInsensitive(paramStr, CMD_ENGINESNIFFERRPMTHRESHOLD)) {
 		engineConfiguration->engineSnifferRpmThreshold = valueI;
 #if EFI_EMULATE_POSITION_SENSORS
@@ -615,6 +631,7 @@ static void setValue(const char *paramStr, const char *valueStr) {
 #endif // EFI_PROD_CODE
 	} else if (strEqualCaseInsensitive(paramStr, "targetvbatt")) {
 		setTable(config->alternatorVoltageTargetTable, valueF);
+		invalidateConfigFieldCrc(config->alternatorVoltageTargetTable);
 	} else if (strEqualCaseInsensitive(paramStr, CMD_DATE)) {
 		// rusEfi console invokes this method with timestamp in local timezone
 		setDateTime(valueStr);
@@ -628,6 +645,12 @@ static void setValue(const char *paramStr, const char *valueStr) {
 	engine->resetEngineSnifferIfInTestMode();
 }
 
+static void setValue(const char *paramStr, const char *valueStr) {
+	applyValue(paramStr, valueStr);
+	// most of commands above and setConfigValueByName() write to engineConfiguration
+	invalidateConfigValueByNameCrc();
+}
+
 void initSettings() {
 #if EFI_SIMULATOR
 	printf("initSettings\n");
@@ -0,0 +1,74 @@
+/**
+ * @file    settings_journal.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "settings_journal.h"
+#include "fast_crc32.h"
+
+SettingsJournal::SettingsJournal(SettingsChunkStore& store, uint8_t *data, size_t size, size_t chunkSize)
+	: m_store(store)
+	, m_data(data)
+	, m_size(size)
+	, m_chunkSize(chunkSize)
+	, m_chunkCount((size + chunkSize - 1) / chunkSize)
+{
+	criticalAssertVoid(m_chunkCount <= EFI_SETTINGS_CHUNK_MAX_COUNT, "too many settings chunks");
+}
+
+/**
+ * @return mask of chunks whose CRC differs from what is stored
+ */
+uint32_t SettingsJournal::computeChunkCrcs(uint32_t *crc) const {
+	uint32_t mask = 0;
+
+	for (size_t i = 0; i < m_chunkCount; i++) {
+		size_t offset = i * m_chunkSize;
+		crc[i] = fastCrc32(m_data + offset, minI(m_chunkSize, m_size - offset));
+
+		if (!m_isStoredKnown || crc[i] != m_storedCrc[i]) {
+			mask |= 1 << i;
+		}
+	}
+
+	return mask;
+}
+
+uint32_t SettingsJournal::getChangedChunks() const {
+	uint32_t crc[EFI_SETTINGS_CHUNK_MAX_COUNT];
+	return computeChunkCrcs(crc);
+}
+
+StorageStatus SettingsJournal::read() {
+	StorageStatus ret = m_store.readChunks(m_data, m_size, m_chunkSize);
+
+	// whatever we have read is what is stored, even if it does not pass validation later
+	m_isStoredKnown = false;
+	if (ret == StorageStatus::Ok) {
+		computeChunkCrcs(m_storedCrc);
+		m_isStoredKnown = true;
+	}
+
+	return ret;
+}
+
+StorageStatus SettingsJournal::write() {
+	// CRC of the data as it is before write: if anything changes while we write, it is rewritten next time
+	uint32_t crc[EFI_SETTINGS_CHUNK_MAX_COUNT];
+	uint32_t changed = computeChunkCrcs(crc);
+
+	StorageStatus ret = m_store.writeChunks(m_data, m_size, m_chunkSize, changed);
+
+	if (ret == StorageStatus::Ok) {
+		memcpy(m_storedCrc, crc, sizeof(m_storedCrc));
+		m_isStoredKnown = true;
+	} else {
+		// we do not know what has made it to storage, rewrite everything next time
+		m_isStoredKnown = false;
+	}
+
+	return ret;
+}
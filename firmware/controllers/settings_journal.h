@@ -0,0 +1,53 @@
+/**
+ * @file    settings_journal.h
+ * @brief   Chunked settings storage: only chunks which changed are rewritten on burn
+ *
+ * Journal keeps CRC of each chunk as it is in storage right now, this catches changes made by
+ * any means (TunerStudio, console, Lua, configuration reset). If we do not know what is stored -
+ * nothing was read yet or last write has failed half way - all chunks are written.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "storage.h"
+
+/**
+ * Storage of chunk records, all chunks of one write go in a single transaction
+ * so after power loss we get either old or new set of chunks, never a mix
+ */
+class SettingsChunkStore {
+public:
+	// Only chunks with corresponding bit set in dirtyMask are written
+	virtual StorageStatus writeChunks(const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask) = 0;
+	virtual StorageStatus readChunks(uint8_t *ptr, size_t size, size_t chunkSize) = 0;
+};
+
+class SettingsJournal {
+public:
+	SettingsJournal(SettingsChunkStore& store, uint8_t *data, size_t size, size_t chunkSize);
+
+	StorageStatus read();
+	StorageStatus write();
+
+	/**
+	 * @return chunks which differ from stored copy
+	 */
+	uint32_t getChangedChunks() const;
+	size_t getChunkCount() const {
+		return m_chunkCount;
+	}
+
+private:
+	uint32_t computeChunkCrcs(uint32_t *crc) const;
+
+	SettingsChunkStore& m_store;
+	uint8_t * const m_data;
+	const size_t m_size;
+	const size_t m_chunkSize;
+	const size_t m_chunkCount;
+
+	uint32_t m_storedCrc[EFI_SETTINGS_CHUNK_MAX_COUNT];
+	bool m_isStoredKnown = false;
+};
@@ -35,6 +35,40 @@ StorageStatus storageRead(int id, uint8_t *ptr, size_t size)
 	return StorageStatus::NotFound;
 }
 
+StorageStatus storageErase(int id)
+{
+#if EFI_STORAGE_MFS == TRUE
+	return mfsStorageErase(id);
+#endif // EFI_STORAGE_MFS
+
+	return StorageStatus::Failed;
+}
+
+StorageStatus storageWriteChunks(int firstId, const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask)
+{
+#if EFI_STORAGE_JOURNAL == TRUE
+	return mfsStorageWriteChunks(firstId, ptr, size, chunkSize, dirtyMask);
+#endif // EFI_STORAGE_JOURNAL
+
+	return StorageStatus::Failed;
+}
+
+StorageStatus storageReadChunks(int firstId, uint8_t *ptr, size_t size, size_t chunkSize)
+{
+#if EFI_STORAGE_JOURNAL == TRUE
+	return mfsStorageReadChunks(firstId, ptr, size, chunkSize);
+#endif // EFI_STORAGE_JOURNAL
+
+	return StorageStatus::NotFound;
+}
+
+void storageCompactIfNeeded()
+{
+#if EFI_STORAGE_MFS == TRUE
+	mfsStorageCompactIfNeeded();
+#endif // EFI_STORAGE_MFS
+}
+
 void initStorage()
 {
 #if EFI_STORAGE_MFS == TRUE
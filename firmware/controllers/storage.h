@@ -6,6 +6,8 @@
  * @author Andrey Gusakov
  */
 
+#pragma once
+
 #ifndef EFI_STORAGE_MFS_EXTERNAL
 #define EFI_STORAGE_MFS_EXTERNAL FALSE
 #endif
@@ -14,11 +16,20 @@
 #define EFI_FLASH_WRITE_THREAD FALSE
 #endif
 
+// Settings are stored as a set of chunk records and only modified chunks are rewritten on burn
+#ifndef EFI_STORAGE_JOURNAL
+#define EFI_STORAGE_JOURNAL FALSE
+#endif
+
 // Sanity check
 #if (EFI_STORAGE_MFS_EXTERNAL == TRUE) && (EFI_FLASH_WRITE_THREAD == FALSE)
 	#error EFI_FLASH_WRITE_THREAD should be enabled if MFS is used for external flash
 #endif
 
+#if (EFI_STORAGE_JOURNAL == TRUE) && (EFI_STORAGE_MFS == FALSE)
+	#error EFI_STORAGE_JOURNAL requires EFI_STORAGE_MFS
+#endif
+
 // Storage status
 enum class StorageStatus {
 	Ok,
@@ -32,6 +43,14 @@ enum class StorageStatus {
 
 StorageStatus storageWrite(int id, const uint8_t *ptr, size_t size);
 StorageStatus storageRead(int id, uint8_t *ptr, size_t size);
+StorageStatus storageErase(int id);
+
+// Chunked access: chunk N of the buffer is stored with id firstId + N
+// Only chunks with corresponding bit set in dirtyMask are written, all of them in one transaction
+StorageStatus storageWriteChunks(int firstId, const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask);
+StorageStatus storageReadChunks(int firstId, uint8_t *ptr, size_t size, size_t chunkSize);
+// Pack storage in advance so following writes do not have to wait for garbage collection
+void storageCompactIfNeeded();
 
 void initStorage();
 
@@ -39,3 +58,10 @@ void initStorage();
 // Convert to enum/class
 #define EFI_SETTINGS_RECORD_ID		1
 #define EFI_LTFT_RECORD_ID			2
+// Compiled Lua script, see lua_bytecode_cache.h
+#define EFI_LUA_BYTECODE_HEADER_RECORD_ID	3
+#define EFI_LUA_BYTECODE_RECORD_ID	4
+// First of the settings chunk records, see EFI_STORAGE_JOURNAL
+#define EFI_SETTINGS_CHUNK_FIRST_RECORD_ID	16
+#define EFI_SETTINGS_CHUNK_SIZE		2048
+#define EFI_SETTINGS_CHUNK_MAX_COUNT	32
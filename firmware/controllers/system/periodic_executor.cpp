@@ -0,0 +1,165 @@
+/**
+ * @file periodic_executor.cpp
+ *
+ * Shared threads for PeriodicJob, see periodic_executor.h
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "periodic_executor.h"
+#include "thread_controller.h"
+#include "perf_trace.h"
+#include "thread_profiler.h"
+
+// lane thread wakes up at least this often even without any jobs
+#define PERIODIC_LANE_MAX_SLEEP CH_CFG_ST_FREQUENCY
+
+static bool isDue(systime_t now, systime_t deadline) {
+	return (int32_t)(now - deadline) >= 0;
+}
+
+PeriodicJob::PeriodicJob(const char* name, PeriodicLane lane, float frequencyHz)
+	: m_name(name)
+	, m_lane(lane)
+	, m_period(CH_CFG_ST_FREQUENCY / frequencyHz)
+{
+}
+
+void PeriodicJob::setPeriod(int periodMs) {
+	float frequencyHz = 1000.0 / periodMs;
+	m_period = CH_CFG_ST_FREQUENCY / frequencyHz;
+}
+
+void PeriodicJobList::add(PeriodicJob& job, systime_t now) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (job.m_isRegistered) {
+		return;
+	}
+
+	job.m_nextRun = now;
+	job.m_next = m_head;
+	m_head = &job;
+	job.m_isRegistered = true;
+}
+
+void PeriodicJobList::remove(PeriodicJob& job) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	// job.m_next is left as is so that lane thread currently looking at this job could still move on
+	for (PeriodicJob** current = &m_head; *current; current = &(*current)->m_next) {
+		if (*current == &job) {
+			*current = job.m_next;
+			job.m_isRegistered = false;
+			return;
+		}
+	}
+}
+
+systime_t PeriodicJobList::runDue(systime_t now, efitick_t nowNt) {
+	systime_t untilNext = PERIODIC_LANE_MAX_SLEEP;
+
+	PeriodicJob* job;
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		job = m_head;
+	}
+
+	while (job) {
+		if (isDue(now, job->m_nextRun)) {
+			{
+				ScopePerf perf(PE::PeriodicControllerPeriodicTask);
+
+				job->PeriodicTask(nowNt);
+			}
+
+			// Same as chThdSleepUntilWindowed() in PeriodicController: keep the rate, not the delay between runs
+			job->m_nextRun += job->m_period;
+			if (isDue(now, job->m_nextRun)) {
+				// Fell a whole period behind, no point running it back to back to catch up
+				job->m_nextRun = now + job->m_period;
+				missedDeadlines++;
+				onPeriodicControllerDeadlineMissed();
+			}
+		}
+
+		systime_t untilJob = job->m_nextRun - now;
+		if (untilJob < untilNext) {
+			untilNext = untilJob;
+		}
+
+		{
+			chibios_rt::CriticalSectionLocker csl;
+			job = job->m_next;
+		}
+	}
+
+	return untilNext;
+}
+
+#if !EFI_UNIT_TEST
+
+template <int TStackSize>
+class PeriodicLaneThread final : public ThreadController<TStackSize> {
+public:
+	PeriodicLaneThread(const char* name, tprio_t priority)
+		: ThreadController<TStackSize>(name, priority)
+	{
+		chBSemObjectInit(&m_wakeup, true);
+	}
+
+	void add(PeriodicJob& job) {
+		jobs.add(job, chVTGetSystemTime());
+		this->start();
+
+		// new job is due right away
+		chBSemSignal(&m_wakeup);
+	}
+
+	void remove(PeriodicJob& job) {
+		jobs.remove(job);
+	}
+
+private:
+	PeriodicJobList jobs;
+
+	void ThreadTask() override {
+		while (!chThdShouldTerminateX()) {
+			systime_t untilNext = jobs.runDue(chVTGetSystemTime(), getTimeNowNt());
+
+			// zero would be TIME_IMMEDIATE, we want to actually let lower priority threads run
+			chBSemWaitTimeout(&m_wakeup, maxI(1, untilNext));
+		}
+	}
+
+	binary_semaphore_t m_wakeup;
+};
+
+static PeriodicLaneThread<256> highLane("periodic hi", PRIO_PERIODIC_HIGH);
+static PeriodicLaneThread<UTILITY_THREAD_STACK_SIZE> lowLane("periodic lo", PRIO_PERIODIC_LOW);
+
+void PeriodicJob::start() {
+	if (m_lane == PeriodicLane::High) {
+		highLane.add(*this);
+	} else {
+		lowLane.add(*this);
+	}
+}
+
+void PeriodicJob::stop() {
+	if (m_lane == PeriodicLane::High) {
+		highLane.remove(*this);
+	} else {
+		lowLane.remove(*this);
+	}
+}
+
+#else
+
+// unit tests drive PeriodicJobList directly
+void PeriodicJob::start() { }
+void PeriodicJob::stop() { }
+
+#endif // EFI_UNIT_TEST
@@ -0,0 +1,84 @@
+/**
+ * @file periodic_executor.h
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "efitime.h"
+
+/**
+ * Each lane is one thread at its own priority, all jobs registered with a lane share its thread and stack.
+ */
+enum class PeriodicLane : uint8_t {
+	// housekeeping which should not be starved by console, logging or SD card
+	High,
+	// LEDs, slow sensors and everything else which could wait
+	Low,
+};
+
+/**
+ * @brief Base class for lightweight periodic work which does not deserve a thread of its own.
+ *
+ * Same idea as PeriodicController but instead of a dedicated thread and stack working area
+ * the job runs on the shared thread of its lane. PeriodicTask() should be short and must not
+ * sleep: every millisecond it takes delays all other jobs on the same lane.
+ */
+class PeriodicJob {
+public:
+	PeriodicJob(const char* name, PeriodicLane lane, float frequencyHz);
+
+	/**
+	 * Register with the lane, PeriodicTask() is invoked right away and then every period
+	 */
+	void start();
+	/**
+	 * Unregister from the lane. Invocation already in progress on the lane thread is not waited for.
+	 */
+	void stop();
+
+	/**
+	 * sets milliseconds period, could be invoked from PeriodicTask() to change the next delay
+	 */
+	void setPeriod(int periodMs);
+
+	const char* const m_name;
+
+protected:
+	/**
+	 * @brief Called periodically on the lane thread.  Override this method to do work for your job.
+	 */
+	virtual void PeriodicTask(efitick_t nowNt) = 0;
+
+private:
+	friend class PeriodicJobList;
+
+	const PeriodicLane m_lane;
+	// time in ChibiOS time units, see CH_CFG_ST_FREQUENCY
+	systime_t m_period;
+	systime_t m_nextRun = 0;
+	bool m_isRegistered = false;
+	PeriodicJob* m_next = nullptr;
+};
+
+/**
+ * Jobs of one lane. Kept apart from the lane thread so that scheduling could be unit tested.
+ */
+class PeriodicJobList {
+public:
+	void add(PeriodicJob& job, systime_t now);
+	void remove(PeriodicJob& job);
+
+	/**
+	 * Invokes all jobs which are due
+	 * @return number of ticks until the next job is due, at most one second
+	 */
+	systime_t runDue(systime_t now, efitick_t nowNt);
+
+	// jobs which fell more than a whole period behind
+	uint32_t missedDeadlines = 0;
+
+private:
+	PeriodicJob* m_head = nullptr;
+};
@@ -10,6 +10,7 @@
 #include "thread_controller.h"
 #include "efitime.h"
 #include "perf_trace.h"
+#include "thread_profiler.h"
 
 /**
  * @brief Base class for a controller that needs to run periodically to perform work.
@@ -71,6 +72,10 @@ private:
 				PeriodicTask(nowNt);
 			}
 
+            if (chVTGetSystemTime() - before > m_period) {
+                onPeriodicControllerDeadlineMissed();
+            }
+
             // This ensures the loop _actually_ runs at the desired frequency.
             // Suppose we want a loop speed of 500hz:
             // If the work takes 1ms, and we wait 2ms (1 / 500hz), we actually
@@ -4,6 +4,7 @@ SYSTEMSRC_CPP =	\
 	$(PROJECT_DIR)/controllers/system/injection_gpio.cpp \
 	$(PROJECT_DIR)/controllers/system/efi_gpio.cpp \
 	$(PROJECT_DIR)/controllers/system/periodic_task.cpp \
+	$(PROJECT_DIR)/controllers/system/periodic_executor.cpp \
 	$(PROJECT_DIR)/controllers/system/dc_motor.cpp \
 	$(PROJECT_DIR)/controllers/system/timer/scheduler.cpp \
 	$(PROJECT_DIR)/controllers/system/timer/trigger_scheduler.cpp \
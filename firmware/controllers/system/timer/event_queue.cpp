@@ -97,6 +97,9 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitick_t timeNt, action_s
 	scheduling->setMomentNt(timeNt);
 	scheduling->action = action;
 
+	m_size++;
+	m_maxSize = maxI(m_maxSize, m_size);
+
 	if (!m_head || timeNt < m_head->getMomentNt()) {
 		// here we insert into head of the linked list
 		LL_PREPEND2(m_head, scheduling, nextScheduling_s);
@@ -134,6 +137,7 @@ void EventQueue::remove(scheduling_s* scheduling) {
 		m_head = m_head->nextScheduling_s;
 		scheduling->nextScheduling_s = nullptr;
 		scheduling->action = {};
+		m_size--;
 	} else {
 		auto prev = m_head;	// keep track of the element before the one to remove, so we can link around it
 		auto current = prev->nextScheduling_s;
@@ -158,6 +162,7 @@ void EventQueue::remove(scheduling_s* scheduling) {
 		// Clean the item to remove
 		current->nextScheduling_s = nullptr;
 		current->action = {};
+		m_size--;
 	}
 
 	assertListIsSorted();
@@ -255,9 +260,17 @@ extern bool unitTestBusyWaitHack;
 		UNIT_TEST_BUSY_WAIT_CALLBACK();
 	}
 
+	// how late are we? events in the near future were spin-waited above so they are not late
+	efidur_t latenessNt = now - current->getMomentNt();
+	if (latenessNt > m_maxLatenessNt) {
+		m_maxLatenessNt = latenessNt;
+	}
+	perfTraceOnSchedulerLateness(latenessNt);
+
 	// step the head forward, unlink this element, clear scheduled flag
 	m_head = current->nextScheduling_s;
 	current->nextScheduling_s = nullptr;
+	m_size--;
 
 	// Grab the action but clear it in the event so we can reschedule from the action's execution
 	auto action = current->action;
@@ -332,4 +345,10 @@ void EventQueue::clear() {
 	}
 
 	m_head = nullptr;
+	m_size = 0;
+}
+
+void EventQueue::resetStatistics() {
+	m_maxSize = m_size;
+	m_maxLatenessNt = 0;
 }
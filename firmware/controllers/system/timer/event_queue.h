@@ -40,6 +40,22 @@ public:
 
 	scheduling_s* getFreeScheduling();
 	void tryReturnScheduling(scheduling_s* sched);
+
+	/**
+	 * Highest number of simultaneously pending events since last statistics reset
+	 */
+	int getMaxSize() const {
+		return m_maxSize;
+	}
+
+	/**
+	 * Worst observed delay between desired and actual execution time since last statistics reset
+	 */
+	efidur_t getMaxLatenessNt() const {
+		return m_maxLatenessNt;
+	}
+
+	void resetStatistics();
 private:
 	void assertListIsSorted() const;
 	/**
@@ -48,6 +64,11 @@ private:
 	scheduling_s *m_head = nullptr;
 	const efidur_t m_lateDelay;
 
+	// O(1) counterpart of size() used for statistics
+	int m_size = 0;
+	int m_maxSize = 0;
+	efidur_t m_maxLatenessNt = 0;
+
 	scheduling_s* m_freelist = nullptr;
 	scheduling_s m_pool[64];
 };
@@ -114,3 +114,11 @@ struct Scheduler {
 
 Scheduler *getScheduler();
 
+/**
+ * Queue for software PWM and other outputs which are not synchronous with engine position, so that
+ * ignition and injection events never sit behind PWM housekeeping in the same queue.
+ * On STM32 both queues share timer interrupt priority, see microsecond_timer_stm32.cpp
+ * Same as getScheduler() unless EFI_LOW_PRIORITY_SCHEDULER
+ */
+Scheduler *getLowPriorityScheduler();
+
@@ -39,9 +39,23 @@ void globalTimerCallback() {
 	___engine.scheduler.onTimerCallback();
 }
 
+#if EFI_LOW_PRIORITY_SCHEDULER
+void globalLowPriorityTimerCallback() {
+	efiAssertVoid(ObdCode::CUSTOM_ERR_6624, hasLotsOfRemainingStack(), "lowstck#2z");
+
+	___engine.lowPriorityScheduler.onTimerCallbackPreemptible();
+}
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+
 SingleTimerExecutor::SingleTimerExecutor()
 	// 8us is roughly the cost of the interrupt + overhead of a single timer event
-	: queue(US2NT(8))
+	: SingleTimerExecutor(US2NT(8), setHardwareSchedulerTimer)
+{
+}
+
+SingleTimerExecutor::SingleTimerExecutor(efidur_t lateDelay, hw_timer_setter_t setTimer)
+	: queue(lateDelay)
+	, m_setTimer(setTimer)
 {
 }
 
@@ -89,6 +103,32 @@ void SingleTimerExecutor::onTimerCallback() {
 	scheduleTimerCallback();
 }
 
+void SingleTimerExecutor::onTimerCallbackPreemptible() {
+	timerCallbackCounter++;
+	executeAllPendingActionsInvocationCounter++;
+
+	int counter = 0;
+	while (true) {
+		chibios_rt::CriticalSectionLocker csl;
+
+		// same as in executeAllPendingActions: actions scheduling further invocations only insert
+		reentrantFlag = true;
+		bool didExecute = queue.executeOne(getTimeNowNt());
+		reentrantFlag = false;
+
+		if (!didExecute) {
+			maxExecuteCounter = maxI(maxExecuteCounter, counter);
+			scheduleTimerCallback();
+			return;
+		}
+
+		// if we're stuck in a loop executing lots of events, panic!
+		if (counter++ == 500) {
+			firmwareError(ObdCode::CUSTOM_ERR_LOCK_ISSUE, "Maximum scheduling run length exceeded - CPU load too high");
+		}
+	}
+}
+
 /*
  * this private method is executed under lock
  */
@@ -151,11 +191,46 @@ void SingleTimerExecutor::scheduleTimerCallback() {
 
 	efiAssertVoid(ObdCode::CUSTOM_ERR_6625, nextEventTimeNt.Value > nowNt, "setTimer constraint");
 
-	setHardwareSchedulerTimer(nowNt, nextEventTimeNt.Value);
+	m_setTimer(nowNt, nextEventTimeNt.Value);
+}
+
+void SingleTimerExecutor::printStatistics(const char *name) {
+	efiPrintf("%s: scheduled=%d timerCallbacks=%d maxRunLength=%d queueSize=%d maxQueueSize=%d maxLateness=%luus",
+			name,
+			scheduleCounter,
+			timerCallbackCounter,
+			maxExecuteCounter,
+			queue.size(),
+			getMaxQueueSize(),
+			(uint32_t)NT2US(getMaxLatenessNt()));
+}
+
+void SingleTimerExecutor::resetStatistics() {
+	chibios_rt::CriticalSectionLocker csl;
+
+	maxExecuteCounter = 0;
+	queue.resetStatistics();
+}
+
+static void printExecutorInfo() {
+	___engine.scheduler.printStatistics("scheduler");
+#if EFI_LOW_PRIORITY_SCHEDULER
+	___engine.lowPriorityScheduler.printStatistics("lowPriorityScheduler");
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+}
+
+static void resetExecutorInfo() {
+	___engine.scheduler.resetStatistics();
+#if EFI_LOW_PRIORITY_SCHEDULER
+	___engine.lowPriorityScheduler.resetStatistics();
+#endif // EFI_LOW_PRIORITY_SCHEDULER
 }
 
 void initSingleTimerExecutorHardware() {
 	initMicrosecondTimer();
+
+	addConsoleAction("executorinfo", printExecutorInfo);
+	addConsoleAction("reset_executor", resetExecutorInfo);
 }
 
 void executorStatistics() {
@@ -166,9 +241,15 @@ void executorStatistics() {
 		engine->outputChannels.debugIntField3 = ___engine.scheduler.scheduleCounter;
 		engine->outputChannels.debugIntField4 = ___engine.scheduler.executeCounter;
 		engine->outputChannels.debugIntField5 = ___engine.scheduler.maxExecuteCounter;
+		engine->outputChannels.debugFloatField1 = ___engine.scheduler.getMaxQueueSize();
+		engine->outputChannels.debugFloatField2 = NT2US(___engine.scheduler.getMaxLatenessNt());
+#if EFI_LOW_PRIORITY_SCHEDULER
+		engine->outputChannels.debugFloatField3 = ___engine.lowPriorityScheduler.scheduleCounter;
+		engine->outputChannels.debugFloatField4 = ___engine.lowPriorityScheduler.getMaxQueueSize();
+		engine->outputChannels.debugFloatField5 = NT2US(___engine.lowPriorityScheduler.getMaxLatenessNt());
+#endif // EFI_LOW_PRIORITY_SCHEDULER
 #endif /* EFI_TUNER_STUDIO */
 	}
 }
 
 #endif /* EFI_SIGNAL_EXECUTOR_ONE_TIMER */
-
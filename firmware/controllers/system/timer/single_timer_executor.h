@@ -9,14 +9,34 @@
 
 #include "scheduler.h"
 #include "event_queue.h"
+#include "microsecond_timer.h"
+
+typedef void (*hw_timer_setter_t)(efitick_t nowNt, efitick_t setTimeNt);
 
 class SingleTimerExecutor final : public Scheduler {
 public:
 	SingleTimerExecutor();
+	/**
+	 * @param setTimer hardware timer (or hardware compare channel) dedicated to this queue
+	 */
+	SingleTimerExecutor(efidur_t lateDelay, hw_timer_setter_t setTimer);
 	void schedule(const char *msg, scheduling_s *scheduling, efitick_t timeNt, action_s action) override;
 	void cancel(scheduling_s* scheduling) override;
 
 	void onTimerCallback();
+	/**
+	 * Same as onTimerCallback but for thread context: lock is taken per action, not for the whole
+	 * run, so interrupts are served between actions.
+	 */
+	void onTimerCallbackPreemptible();
+	void printStatistics(const char *name);
+	void resetStatistics();
+	int getMaxQueueSize() const {
+		return queue.getMaxSize();
+	}
+	efidur_t getMaxLatenessNt() const {
+		return queue.getMaxLatenessNt();
+	}
 	int timerCallbackCounter = 0;
 	int scheduleCounter = 0;
 	int maxExecuteCounter = 0;
@@ -24,6 +44,7 @@ public:
 	int executeAllPendingActionsInvocationCounter = 0;
 private:
 	EventQueue queue;
+	const hw_timer_setter_t m_setTimer;
 	bool reentrantFlag = false;
 	void executeAllPendingActions();
 	void scheduleTimerCallback();
@@ -8,6 +8,10 @@
 
 #pragma once
 
+// Low priority scheduler actions (software PWM etc) used to run in the timer ISR, they are short so
+// keep them above everything else, see microsecond_timer.cpp
+#define PRIO_LOW_PRIORITY_SCHEDULER (NORMALPRIO + 11)
+
 // ADC and ETB get highest priority - not much else actually runs the engine
 #define PRIO_ADC (NORMALPRIO + 10)
 #define PRIO_ETB (NORMALPRIO + 9)
@@ -23,6 +27,10 @@
 #define PRIO_SERVO (NORMALPRIO + 5)
 #define PRIO_STEPPER (NORMALPRIO + 5)
 
+// Shared threads for lightweight periodic jobs, see periodic_executor.h
+#define PRIO_PERIODIC_HIGH (NORMALPRIO + 5)
+#define PRIO_PERIODIC_LOW (NORMALPRIO - 1)
+
 // Logging buffer flush is *slightly* above PRIO_CONSOLE so that we don't starve logging buffers during initialization and console commands
 #define PRIO_TEXT_LOG (NORMALPRIO + 4)
 
@@ -51,6 +59,3 @@
 
 // Lua interpreter must be lowest priority, as the user's code may get stuck in an infinite loop
 #define PRIO_LUA LOWPRIO + 10
-
-// MAX31855 driver
-#define MAX31855_PRIO NORMALPRIO
@@ -43,8 +43,11 @@
 #include "sensor_chart.h"
 #endif /* EFI_SENSOR_CHART */
 
-TriggerWaveform::TriggerWaveform() {
-	initialize(OM_NONE, SyncEdge::Rise);
+TriggerWaveform::TriggerWaveform(float *switchTimes, uint8_t *waveForm, bool *p_isRiseEvent, size_t maxSize)
+	: wave(switchTimes, waveForm, maxSize)
+	, isRiseEvent(p_isRiseEvent)
+{
+	// storage is not constructed yet, TriggerWaveformWithData invokes initialize()
 }
 
 void TriggerWaveform::initialize(operation_mode_e p_operationMode, SyncEdge p_syncEdge) {
@@ -76,7 +79,7 @@ void TriggerWaveform::initialize(operation_mode_e p_operationMode, SyncEdge p_sy
 	wave.waveCount = TRIGGER_INPUT_PIN_COUNT;
 	wave.phaseCount = 0;
 	previousAngle = 0;
-	setArrayValues(isRiseEvent, 0);
+	memset(isRiseEvent, 0, getMaxSize() * sizeof(isRiseEvent[0]));
 #if EFI_UNIT_TEST
 	memset(triggerSignalIndeces, 0, sizeof(triggerSignalIndeces));
 	memset(&triggerSignalStates, 0, sizeof(triggerSignalStates));
@@ -88,6 +91,10 @@ size_t TriggerWaveform::getSize() const {
 	return wave.phaseCount;
 }
 
+size_t TriggerWaveform::getMaxSize() const {
+	return wave.getMaxPhaseCount();
+}
+
 int TriggerWaveform::getTriggerWaveformSynchPointIndex() const {
 	return triggerShapeSynchPointIndex;
 }
@@ -295,6 +302,12 @@ void TriggerWaveform::addEvent(angle_t angle, TriggerValue const state, TriggerW
 			return;
 		}
 	}
+	if (wave.phaseCount >= getMaxSize()) {
+		firmwareError(ObdCode::CUSTOM_ERR_TRIGGER_WAVEFORM_TOO_LONG, "Trigger length above maximum: %d", getMaxSize());
+		setShapeDefinitionError(true);
+		return;
+	}
+
 	previousAngle = angle;
 	if (wave.phaseCount == 0) {
 		wave.phaseCount = 1;
@@ -363,6 +376,7 @@ void TriggerWaveform::setTriggerSynchronizationGap3(int gapIndex, float syncRati
 		this->syncRatioAvg = (int)efiRound((syncRatioFrom + syncRatioTo) * 0.5f, 1.0f);
 	}
 	gapTrackingLength = maxI(1 + gapIndex, gapTrackingLength);
+	prepareSyncGapThresholds();
 
 #if EFI_UNIT_TEST
 	if (printTriggerDebug) {
@@ -372,6 +386,29 @@ void TriggerWaveform::setTriggerSynchronizationGap3(int gapIndex, float syncRati
 
 }
 
+static uint32_t toSyncGapFixed(float ratio) {
+	// NaN 'to' means range which is never matched, same as float comparison would do
+	if (std::isnan(ratio) || ratio <= 0) {
+		return 0;
+	}
+	float scaled = ratio * (1 << SYNC_GAP_FIXED_SHIFT);
+	if (scaled >= (float)UINT32_MAX) {
+		return UINT32_MAX;
+	}
+	return (uint32_t)(scaled + 0.5f);
+}
+
+void TriggerWaveform::prepareSyncGapThresholds() {
+	syncGapSkipMask = 0;
+	for (int i = 0; i < GAP_TRACKING_LENGTH; i++) {
+		if (std::isnan(synchronizationRatioFrom[i])) {
+			syncGapSkipMask |= 1 << i;
+		}
+		syncGapFromFixed[i] = toSyncGapFixed(synchronizationRatioFrom[i]);
+		syncGapToFixed[i] = toSyncGapFixed(synchronizationRatioTo[i]);
+	}
+}
+
 uint16_t TriggerWaveform::findAngleIndex(TriggerFormDetails *details, angle_t targetAngle) const {
 	size_t engineCycleEventCount = getLength();
 
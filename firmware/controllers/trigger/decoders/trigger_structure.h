@@ -58,13 +58,27 @@ class TriggerConfiguration;
 
 #include "sync_edge.h"
 
+/**
+ * Sync gap ratios are kept as Q16 fixed point: resolution is 1/65536, ratios above 65535 are clamped
+ */
+#define SYNC_GAP_FIXED_SHIFT 16
+
+static_assert(GAP_TRACKING_LENGTH <= 32, "syncGapSkipMask is too narrow");
+
 /**
  * @brief Trigger shape has all the fields needed to describe and decode trigger signal.
  * @see TriggerState for trigger decoder state which works based on this trigger shape model
+ * @see TriggerWaveformWithData which owns the event arrays
  */
 class TriggerWaveform {
+protected:
+	TriggerWaveform(float *switchTimes, uint8_t *waveForm, bool *isRiseEvent, size_t maxSize);
+
 public:
-	TriggerWaveform();
+	// 'wave' points into the storage of the instance, copy would point into someone else's storage
+	TriggerWaveform(const TriggerWaveform&) = delete;
+	TriggerWaveform& operator=(const TriggerWaveform&) = delete;
+
 	void initializeTriggerWaveform(operation_mode_e triggerOperationMode, const trigger_config_s &triggerType, bool isCrankWheel = true);
 	void setShapeDefinitionError(bool value);
 
@@ -112,6 +126,36 @@ public:
 	float synchronizationRatioFrom[GAP_TRACKING_LENGTH];
 	float synchronizationRatioTo[GAP_TRACKING_LENGTH];
 
+	/**
+	 * Fixed point copy of synchronizationRatioFrom/To, see prepareSyncGapThresholds()
+	 * Gap check is done on every tooth from trigger ISR so we want it without any float or division
+	 */
+	uint32_t syncGapFromFixed[GAP_TRACKING_LENGTH];
+	uint32_t syncGapToFixed[GAP_TRACKING_LENGTH];
+	/**
+	 * bit is set for gaps with NaN 'from' - we do not track gap at this depth
+	 */
+	uint32_t syncGapSkipMask = 0;
+
+	/**
+	 * Converts float gap ratios into fixed point thresholds, has to be invoked after any
+	 * change of synchronizationRatioFrom/To
+	 */
+	void prepareSyncGapThresholds();
+
+	bool isSyncGapSkipped(int gapIndex) const {
+		return syncGapSkipMask & (1 << gapIndex);
+	}
+
+	/**
+	 * Same as 'from < current / previous < to' while using just two integer multiplications
+	 */
+	bool isSyncGapInRange(int gapIndex, uint32_t current, uint32_t previous) const {
+		uint64_t scaledCurrent = (uint64_t)current << SYNC_GAP_FIXED_SHIFT;
+		return scaledCurrent > (uint64_t)previous * syncGapFromFixed[gapIndex]
+			&& scaledCurrent < (uint64_t)previous * syncGapToFixed[gapIndex];
+	}
+
 
 	/**
 	 * used by NoiselessTriggerDecoder (See TriggerCentral::handleShaftSignal())
@@ -168,9 +212,12 @@ public:
 	 * but name is supposed to hint at the fact that decoders should not be assigning to it
 	 * Please use "getSize()" function to read this value
 	 */
-	MultiChannelStateSequenceWithData<PWM_PHASE_MAX_COUNT> wave;
+	MultiChannelStateSequenceView wave;
 
-	bool isRiseEvent[PWM_PHASE_MAX_COUNT];
+	/**
+	 * getMaxSize() elements
+	 */
+	bool * const isRiseEvent;
 
 	/**
 	 * @param angle (0..1]
@@ -221,6 +268,10 @@ public:
 	 */
 	size_t getLength() const;
 	size_t getSize() const;
+	/**
+	 * Maximum number of events this instance has room for
+	 */
+	size_t getMaxSize() const;
 
 	int getTriggerWaveformSynchPointIndex() const;
 
@@ -265,6 +316,26 @@ private:
 	operation_mode_e operationMode;
 };
 
+template <size_t TMaxSize>
+class TriggerWaveformWithData : public TriggerWaveform {
+public:
+	TriggerWaveformWithData()
+		: TriggerWaveform(m_switchTimes, m_waveForm, m_isRiseEvent, TMaxSize)
+	{
+		initialize(OM_NONE, SyncEdge::Rise);
+	}
+
+private:
+	float m_switchTimes[TMaxSize];
+	uint8_t m_waveForm[TMaxSize];
+	bool m_isRiseEvent[TMaxSize];
+};
+
+// Crank wheel, or any wheel at all
+using TriggerWaveformFull = TriggerWaveformWithData<PWM_PHASE_MAX_COUNT>;
+// Cam wheel used for VVT
+using TriggerWaveformVvt = TriggerWaveformWithData<VVT_PHASE_MAX_COUNT>;
+
 /**
  * Misc values calculated from TriggerWaveform
  */
@@ -1007,42 +1007,33 @@ static void resetRunningTriggerCounters() {
 }
 
 void onConfigurationChangeTriggerCallback() {
-	bool changed = false;
 	// todo: how do we static_assert here?
 	criticalAssertVoid(efi::size(engineConfiguration->camInputs) == efi::size(engineConfiguration->vvtOffsets), "sizes");
 
-	for (size_t camIndex = 0; camIndex < efi::size(engineConfiguration->camInputs); camIndex++) {
-		changed |= isConfigurationChanged(camInputs[camIndex]);
-		changed |= isConfigurationChanged(vvtOffsets[camIndex]);
-	}
-
-	for (size_t i = 0; i < efi::size(engineConfiguration->triggerGapOverrideFrom); i++) {
-		changed |= isConfigurationChanged(triggerGapOverrideFrom[i]);
-		changed |= isConfigurationChanged(triggerGapOverrideTo[i]);
-	}
-
 	for (size_t i = 0; i < efi::size(engineConfiguration->triggerInputPins); i++) {
-		changed |= isConfigurationChanged(triggerInputPins[i]);
 		Gpio pin = engineConfiguration->camInputs[i];
 		if (engineConfiguration->vvtMode[0] == VVT_MAP_V_TWIN && isBrainPinValid(pin)) {
 		    criticalError("Please no physical sensors in CAM by MAP mode index=%d %s", i, hwPortname(pin));
 		}
 	}
 
-	for (size_t i = 0; i < efi::size(engineConfiguration->vvtMode); i++) {
-		changed |= isConfigurationChanged(vvtMode[i]);
-	}
-
-	changed |= isConfigurationChanged(trigger.type);
-	changed |= isConfigurationChanged(skippedWheelOnCam);
-	changed |= isConfigurationChanged(twoStroke);
-	changed |= isConfigurationChanged(globalTriggerAngleOffset);
-	changed |= isConfigurationChanged(trigger.customTotalToothCount);
-	changed |= isConfigurationChanged(trigger.customSkippedToothCount);
-	changed |= isConfigurationChanged(overrideTriggerGaps);
-	changed |= isConfigurationChanged(gapTrackingLengthOverride);
-	changed |= isConfigurationChanged(overrideVvtTriggerGaps);
-	changed |= isConfigurationChanged(gapVvtTrackingLengthOverride);
+	engine_configuration_s const * previousConfig = &activeConfiguration;
+	bool changed = isConfigurationFieldChanged(previousConfig, camInputs)
+		|| isConfigurationFieldChanged(previousConfig, vvtOffsets)
+		|| isConfigurationFieldChanged(previousConfig, triggerGapOverrideFrom)
+		|| isConfigurationFieldChanged(previousConfig, triggerGapOverrideTo)
+		|| isConfigurationFieldChanged(previousConfig, triggerInputPins)
+		|| isConfigurationFieldChanged(previousConfig, vvtMode)
+		// type and custom tooth counts
+		|| isConfigurationFieldChanged(previousConfig, trigger)
+		|| isConfigurationFieldChanged(previousConfig, globalTriggerAngleOffset)
+		|| isConfigurationFieldChanged(previousConfig, gapTrackingLengthOverride)
+		|| isConfigurationFieldChanged(previousConfig, gapVvtTrackingLengthOverride)
+		// bit fields
+		|| isConfigurationChanged(skippedWheelOnCam)
+		|| isConfigurationChanged(twoStroke)
+		|| isConfigurationChanged(overrideTriggerGaps)
+		|| isConfigurationChanged(overrideVvtTriggerGaps);
 
 	if (changed) {
 	#if EFI_ENGINE_CONTROL
@@ -1087,8 +1078,7 @@ static void calculateTriggerSynchPoint(
 
 	shape.initializeSyncPoint(initState, primaryTriggerConfiguration);
 
-	if (shape.getSize() >= PWM_PHASE_MAX_COUNT) {
-		// todo: by the time we are here we had already modified a lot of RAM out of bounds!
+	if (shape.getSize() >= shape.getMaxSize()) {
 		firmwareError(ObdCode::CUSTOM_ERR_TRIGGER_WAVEFORM_TOO_LONG, "Trigger length above maximum: %d", shape.getSize());
 		shape.setShapeDefinitionError(true);
 		return;
@@ -176,7 +176,7 @@ public:
 	PrimaryTriggerDecoder triggerState;
 #endif //EFI_SHAFT_POSITION_INPUT
 
-	TriggerWaveform triggerShape;
+	TriggerWaveformFull triggerShape;
 
 	VvtTriggerDecoder vvtState[BANKS_COUNT][CAMS_PER_BANK] = {
 		{
@@ -195,7 +195,7 @@ public:
 #endif
 	};
 
-	TriggerWaveform vvtShape[CAMS_PER_BANK];
+	TriggerWaveformVvt vvtShape[CAMS_PER_BANK];
 
 	TriggerFormDetails triggerFormDetails;
 
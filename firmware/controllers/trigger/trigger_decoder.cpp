@@ -109,6 +109,8 @@ bool printTriggerTrace = false;
 
 void TriggerWaveform::initializeSyncPoint(TriggerDecoderBase& state,
 			const TriggerConfiguration& triggerConfiguration) {
+	// gap overrides write synchronizationRatioFrom/To directly
+	prepareSyncGapThresholds();
 	triggerShapeSynchPointIndex = state.findTriggerZeroEventIndex(*this, triggerConfiguration);
 }
 
@@ -155,7 +157,7 @@ void TriggerFormDetails::prepareEventAngles(TriggerWaveform *shape) {
 
 			if (shape->useOnlyRisingEdges) {
 				criticalAssertVoid(triggerDefinitionIndex < triggerShapeLength, "trigger shape fail");
-				assertIsInBounds(triggerDefinitionIndex, shape->isRiseEvent, "isRise");
+				criticalAssertVoid(triggerDefinitionIndex < shape->getMaxSize(), "isRise");
 
 				// In case this is a rising event, replace the following fall event with the rising as well
 				if (shape->isRiseEvent[triggerDefinitionIndex]) {
@@ -455,9 +457,11 @@ expected<TriggerDecodeResult> TriggerDecoderBase::decodeTriggerEvent(
 		bool wasSynchronized = getShaftSynchronized();
 
 		if (triggerShape.isSynchronizationNeeded) {
-			triggerSyncGapRatio = (float)toothDurations[0] / toothDurations[1];
+			// ratio itself is only needed for diagnostics, see updateSyncGapRatio()
+			syncGapCurrent = toothDurations[0];
+			syncGapPrevious = toothDurations[1];
 
-			if (wasSynchronized && triggerSyncGapRatio > NOISE_RATIO_THRESHOLD) {
+			if (wasSynchronized && toothDurations[0] > (uint64_t)toothDurations[1] * NOISE_RATIO_THRESHOLD) {
 			    setTriggerErrorState(100);
 			}
 
@@ -598,7 +602,7 @@ expected<TriggerDecodeResult> TriggerDecoderBase::decodeTriggerEvent(
 #if EFI_UNIT_TEST
         if (wasSynchronized) {
             int uiGapIndex = (currentCycle.current_index) % triggerShape.getLength();
-            gapRatio[uiGapIndex] = triggerSyncGapRatio;
+            gapRatio[uiGapIndex] = getSyncGapRatio();
         }
 #endif // EFI_UNIT_TEST
 	}
@@ -646,10 +650,13 @@ bool TriggerDecoderBase::isSyncPoint(const TriggerWaveform& triggerShape, trigge
 	// Instead of detecting short/long, this logic first checks for "maybe short" and "maybe long",
 	// then simply tests longer vs. shorter instead of absolute value.
 	if (triggerType == trigger_type_e::TT_MIATA_VVT) {
-		auto secondGap = (float)toothDurations[1] / toothDurations[2];
-
-		bool currentGapOk = isInRange(triggerShape.synchronizationRatioFrom[0], (float)triggerSyncGapRatio, triggerShape.synchronizationRatioTo[0]);
-		bool secondGapOk  = isInRange(triggerShape.synchronizationRatioFrom[1], secondGap,  triggerShape.synchronizationRatioTo[1]);
+		// inclusive range, same as isInRange()
+		uint64_t current = (uint64_t)toothDurations[0] << SYNC_GAP_FIXED_SHIFT;
+		uint64_t second = (uint64_t)toothDurations[1] << SYNC_GAP_FIXED_SHIFT;
+		bool currentGapOk = current >= (uint64_t)toothDurations[1] * triggerShape.syncGapFromFixed[0]
+			&& current <= (uint64_t)toothDurations[1] * triggerShape.syncGapToFixed[0];
+		bool secondGapOk = second >= (uint64_t)toothDurations[2] * triggerShape.syncGapFromFixed[1]
+			&& second <= (uint64_t)toothDurations[2] * triggerShape.syncGapToFixed[1];
 
 		// One or both teeth was impossible range, this is not the sync point
 		if (!currentGapOk || !secondGapOk) {
@@ -658,27 +665,22 @@ bool TriggerDecoderBase::isSyncPoint(const TriggerWaveform& triggerShape, trigge
 
 		// If both teeth are in the range of possibility, return whether this gap is
 		// shorter than the last or not.  If it is, this is the sync point.
-		return triggerSyncGapRatio < secondGap;
+		// toothDurations[0] / toothDurations[1] < toothDurations[1] / toothDurations[2]
+		return (uint64_t)toothDurations[0] * toothDurations[2] < (uint64_t)toothDurations[1] * toothDurations[1];
 	}
 
 	for (int i = 0; i < triggerShape.gapTrackingLength; i++) {
-		auto from = triggerShape.synchronizationRatioFrom[i];
-		auto to = triggerShape.synchronizationRatioTo[i];
-
-		if (std::isnan(from)) {
+		if (triggerShape.isSyncGapSkipped(i)) {
 			// don't check this gap, skip it
 			continue;
 		}
 
-		// This is transformed to avoid a division and use a cheaper multiply instead
+		// Thresholds are prepared as fixed point so that
 		// toothDurations[i] / toothDurations[i+1] > from
-		// is an equivalent comparison to
-		// toothDurations[i] > toothDurations[i+1] * from
-		bool isGapCondition =
-			  (toothDurations[i] > toothDurations[i + 1] * from
-			&& toothDurations[i] < toothDurations[i + 1] * to);
-
-		if (!isGapCondition) {
+		// is checked as
+		// (toothDurations[i] << SHIFT) > toothDurations[i+1] * fromFixed
+		// without any division or float math
+		if (!triggerShape.isSyncGapInRange(i, toothDurations[i], toothDurations[i + 1])) {
 			return false;
 		}
 	}
@@ -129,6 +129,23 @@ public:
 	 */
 	uint32_t toothDurations[GAP_TRACKING_LENGTH + 1];
 
+	/**
+	 * Durations compared by the most recent sync gap check, the ratio is not computed on every tooth
+	 */
+	uint32_t syncGapCurrent = 0;
+	uint32_t syncGapPrevious = 0;
+
+	float getSyncGapRatio() const {
+		return (float)syncGapCurrent / syncGapPrevious;
+	}
+
+	/**
+	 * Invoked from slow callback to refresh triggerSyncGapRatio for TunerStudio
+	 */
+	void updateSyncGapRatio() {
+		triggerSyncGapRatio = getSyncGapRatio();
+	}
+
 	efitick_t toothed_previous_time;
 
 	current_cycle_state_s currentCycle;
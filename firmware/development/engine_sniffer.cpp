@@ -31,10 +31,14 @@
 // a bit weird because of conditional compilation
 static char shaft_signal_msg_index[15];
 
+/**
+ * 'msg' is only evaluated in text mode, binary mode does not spend any time on text
+ */
 #if EFI_ENGINE_SNIFFER
-#define addEngineSnifferEvent(name, msg) { if (getTriggerCentral()->isEngineSnifferEnabled) { waveChart.addEvent3((name), (msg)); } }
+#define addEngineSnifferEvent(name, kind, value, msg) { if (getTriggerCentral()->isEngineSnifferEnabled) { \
+	if (waveChart.isBinaryMode()) { waveChart.addBinaryEvent((name), (kind), (value)); } else { waveChart.addEvent3((name), (msg)); } } }
  #else
-#define addEngineSnifferEvent(name, msg) { UNUSED(name); }
+#define addEngineSnifferEvent(name, kind, value, msg) { UNUSED(name); UNUSED(kind); UNUSED(value); UNUSED(msg); }
 #endif /* EFI_ENGINE_SNIFFER */
 
 #if EFI_ENGINE_SNIFFER
@@ -57,6 +61,39 @@ extern WaveChart waveChart;
 
 static char WAVE_LOGGING_BUFFER[WAVE_LOGGING_SIZE] CCM_OPTIONAL;
 
+// Longest text of one binary event besides channel name: three delimiters, 'u_65535' and 32 bit time
+#define SNIFFER_EVENT_TEXT_OVERHEAD 20
+static_assert(sizeof(PROTOCOL_ES_UP) <= 8 && sizeof(PROTOCOL_ES_DOWN) <= 8);
+
+// 512 events, binary chart is decoded into WAVE_LOGGING_BUFFER a piece at a time so text size does not matter here
+#define SNIFFER_EVENTS_BUFFER_SIZE 4096
+
+/**
+ * Binary events refer to channel names by index. Names are string literals or pin names
+ * which stay around forever, so comparing pointers is enough
+ */
+#define SNIFFER_MAX_CHANNELS 64
+static const char* snifferChannelNames[SNIFFER_MAX_CHANNELS];
+static uint8_t snifferChannelNameLength[SNIFFER_MAX_CHANNELS];
+static size_t snifferChannelCount = 0;
+
+/**
+ * @return -1 if there is no room for new channel
+ */
+static int getSnifferChannel(const char *name) {
+	for (size_t i = 0; i < snifferChannelCount; i++) {
+		if (snifferChannelNames[i] == name) {
+			return i;
+		}
+	}
+	if (snifferChannelCount == SNIFFER_MAX_CHANNELS) {
+		return -1;
+	}
+	snifferChannelNames[snifferChannelCount] = name;
+	snifferChannelNameLength[snifferChannelCount] = strlen(name);
+	return snifferChannelCount++;
+}
+
 int waveChartUsedSize;
 
 /**
@@ -70,6 +107,11 @@ static void resetNow() {
 	skipUntilEngineCycle = getRevolutionCounter() + 3;
 	waveChart.reset();
 }
+
+static void setSnifferBinaryMode(int value) {
+	waveChart.setBinaryMode(value);
+	efiPrintf("engine sniffer binary mode: %s", boolToString(waveChart.isBinaryMode()));
+}
 #endif // EFI_UNIT_TEST
 
 WaveChart::WaveChart() : logging("wave chart", WAVE_LOGGING_BUFFER, sizeof(WAVE_LOGGING_BUFFER)) {
@@ -82,12 +124,41 @@ void WaveChart::init() {
 
 void WaveChart::reset() {
 	logging.reset();
+	// before counter so that concurrent binary event is lost rather than garbage is decoded
+	chartStartPosition = writePosition;
 	counter = 0;
 	startTimeNt = 0;
 	collectingData = false;
 	logging.appendPrintf( "%s%s", PROTOCOL_ENGINE_SNIFFER, LOG_DELIMITER);
 }
 
+void WaveChart::setBinaryMode(bool value) {
+	if (value == isBinaryMode()) {
+		return;
+	}
+
+	BigBufferHandle buffer;
+	if (value) {
+		buffer = getBigBuffer(BigBufferUser::EngineSniffer, SNIFFER_EVENTS_BUFFER_SIZE);
+		if (!buffer) {
+			// big buffer is busy with something else, stay with text
+			return;
+		}
+	}
+
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		eventsBuffer = std::move(buffer);
+		events = eventsBuffer.get<SnifferEvent>();
+		eventsCapacity = eventsBuffer.size() / sizeof(SnifferEvent);
+		writePosition = 0;
+		snifferChannelCount = 0;
+	}
+
+	// whatever was collected so far is in the other format
+	reset();
+}
+
 void WaveChart::startDataCollection() {
 	collectingData = true;
 }
@@ -104,6 +175,9 @@ bool WaveChart::isStartedTooLongAgo() const {
 }
 
 bool WaveChart::isFull() const {
+	if (events && counter >= eventsCapacity) {
+		return true;
+	}
 	return counter >= engineConfiguration->engineChartSize;
 }
 
@@ -135,36 +209,175 @@ void WaveChart::publishIfFull() {
 
 void WaveChart::publish() {
 #if EFI_ENGINE_SNIFFER
+	if (events) {
+		publishBinaryEvents();
+		return;
+	}
 	logging.appendPrintf( LOG_DELIMITER);
 	waveChartUsedSize = logging.loggingSize();
 
 	if (getTriggerCentral()->isEngineSnifferEnabled) {
-		scheduleLogging(&logging);
+		schedulePiece(/*isFirstPiece*/true, /*isLastPiece*/true);
 	}
 #endif /* EFI_ENGINE_SNIFFER */
 }
 
+void WaveChart::schedulePiece(bool isFirstPiece, bool isLastPiece) {
+#if EFI_UNIT_TEST
+	if (isFirstPiece) {
+		publishedText.clear();
+	}
+	publishedText += logging.buffer;
+	UNUSED(isLastPiece);
+	logging.reset();
+#else
+	scheduleLoggingPiece(&logging, isFirstPiece, isLastPiece);
+#endif // EFI_UNIT_TEST
+}
+
 /**
- * @brief	Register an event for digital sniffer
+ * Produces exactly the same text as addEvent3() would have produced at the time of each event.
+ * Chart could be longer than WAVE_LOGGING_BUFFER, it goes out in a number of pieces
  */
-void WaveChart::addEvent3(const char *name, const char * msg) {
+void WaveChart::publishBinaryEvents() {
+	if (!getTriggerCentral()->isEngineSnifferEnabled) {
+		return;
+	}
+
+	uint32_t count;
+	uint32_t position;
+	{
+		// new events could only go after these
+		chibios_rt::CriticalSectionLocker csl;
+		count = counter;
+		position = chartStartPosition;
+	}
+
+	uint32_t diffNt = 0;
+	bool isFirstPiece = true;
+	waveChartUsedSize = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const SnifferEvent& event = events[position];
+		if (++position == eventsCapacity) {
+			position = 0;
+		}
+
+		// closing delimiter has to fit after any event
+		if (logging.remainingSize() < snifferChannelNameLength[event.channel] + SNIFFER_EVENT_TEXT_OVERHEAD + sizeof(LOG_DELIMITER)) {
+			waveChartUsedSize += logging.loggingSize();
+			schedulePiece(isFirstPiece, /*isLastPiece*/false);
+			isFirstPiece = false;
+		}
+
+		diffNt += event.deltaNt;
+		uint32_t time100 = NT2US(diffNt / ENGINE_SNIFFER_UNIT_US);
+
+		logging.appendFast(snifferChannelNames[event.channel]);
+		logging.appendChar(CHART_DELIMETER);
+		switch (event.kind) {
+		case SnifferEventKind::Up:
+			logging.appendFast(PROTOCOL_ES_UP);
+			break;
+		case SnifferEventKind::Down:
+			logging.appendFast(PROTOCOL_ES_DOWN);
+			break;
+		case SnifferEventKind::CrankUp:
+		case SnifferEventKind::CrankDown:
+			logging.appendChar(event.kind == SnifferEventKind::CrankUp ? 'u' : 'd');
+			logging.appendChar('_');
+			// falls through
+		case SnifferEventKind::TopDeadCenter:
+			itoa10(timeBuffer, event.value);
+			logging.appendFast(timeBuffer);
+			break;
+		}
+		logging.appendChar(CHART_DELIMETER);
+
+		itoa10(timeBuffer, time100);
+		logging.appendFast(timeBuffer);
+		logging.appendChar(CHART_DELIMETER);
+		logging.terminate();
+	}
+
+	logging.appendFast(LOG_DELIMITER);
+	waveChartUsedSize += logging.loggingSize();
+	schedulePiece(isFirstPiece, /*isLastPiece*/true);
+}
+
+bool WaveChart::acceptsEvents(efitick_t nowNt) const {
+	if (nowNt < pauseEngineSnifferUntilNt) {
+		return false;
+	}
+	if (!getTriggerCentral()->isEngineSnifferEnabled) {
+		return false;
+	}
+	if (skipUntilEngineCycle != 0 && getRevolutionCounter() < skipUntilEngineCycle)
+		return false;
+#if EFI_SIMULATOR
+	if (!collectingData) {
+		return false;
+	}
+#endif
+	return true;
+}
+
+/**
+ * @brief	Register an event for digital sniffer, binary mode
+ * Fixed size record and no division here, see decodeBinaryEvents()
+ */
+void WaveChart::addBinaryEvent(const char *name, SnifferEventKind kind, uint16_t value) {
 #if EFI_TEXT_LOGGING
 	ScopePerf perf(PE::EngineSniffer);
 	efitick_t nowNt = getTimeNowNt();
 
-	if (nowNt < pauseEngineSnifferUntilNt) {
+	if (!acceptsEvents(nowNt)) {
 		return;
 	}
-	if (!getTriggerCentral()->isEngineSnifferEnabled) {
+	efiAssertVoid(ObdCode::CUSTOM_ERR_6651, name!=NULL, "WC: NULL name");
+	efiAssertVoid(ObdCode::CUSTOM_ERR_6653, isInitialized, "chart not initialized");
+
+	// we have multiple threads writing to the same ring
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (!events || isFull()) {
 		return;
 	}
-	if (skipUntilEngineCycle != 0 && getRevolutionCounter() < skipUntilEngineCycle)
+
+	int channel = getSnifferChannel(name);
+	if (channel < 0) {
 		return;
-#if EFI_SIMULATOR
-	if (!collectingData) {
+	}
+
+	if (counter == 0) {
+		startTimeNt = nowNt;
+		lastEventNt = nowNt;
+	}
+	counter++;
+
+	SnifferEvent& event = events[writePosition];
+	if (++writePosition == eventsCapacity) {
+		writePosition = 0;
+	}
+
+	event.channel = channel;
+	event.kind = kind;
+	event.value = value;
+	event.deltaNt = nowNt - lastEventNt;
+	lastEventNt = nowNt;
+#endif /* EFI_TEXT_LOGGING */
+}
+
+/**
+ * @brief	Register an event for digital sniffer
+ */
+void WaveChart::addEvent3(const char *name, const char * msg) {
+#if EFI_TEXT_LOGGING
+	ScopePerf perf(PE::EngineSniffer);
+	efitick_t nowNt = getTimeNowNt();
+
+	if (!acceptsEvents(nowNt)) {
 		return;
 	}
-#endif
 	efiAssertVoid(ObdCode::CUSTOM_ERR_6651, name!=NULL, "WC: NULL name");
 
 #if EFI_PROD_CODE
@@ -229,6 +442,7 @@ void initWaveChart(WaveChart *chart) {
 #if ! EFI_UNIT_TEST
 	printStatus();
 	addConsoleActionI("chartsize", setChartSize);
+	addConsoleActionI("sniffer_binary", setSnifferBinaryMode);
 	// this is used by HW CI
 	addConsoleAction(CMD_RESET_ENGINE_SNIFFER, resetNow);
 #endif // EFI_UNIT_TEST
@@ -236,41 +450,57 @@ void initWaveChart(WaveChart *chart) {
 
 #endif /* EFI_ENGINE_SNIFFER */
 
+static SnifferEventKind edgeKind(FrontDirection frontDirection) {
+	return frontDirection == FrontDirection::UP ? SnifferEventKind::Up : SnifferEventKind::Down;
+}
+
+static const char* edgeMessage(FrontDirection frontDirection) {
+	return frontDirection == FrontDirection::UP ? PROTOCOL_ES_UP : PROTOCOL_ES_DOWN;
+}
+
 void addEngineSnifferOutputPinEvent(NamedOutputPin *pin, FrontDirection frontDirection) {
 	if (!engineConfiguration->engineSnifferFocusOnInputs) {
-		addEngineSnifferEvent(pin->getShortName(), frontDirection == FrontDirection::UP ? PROTOCOL_ES_UP : PROTOCOL_ES_DOWN);
+		addEngineSnifferEvent(pin->getShortName(), edgeKind(frontDirection), 0, edgeMessage(frontDirection));
 	}
 }
 
-void addEngineSnifferTdcEvent(int rpm) {
+static const char* rpmMessage(int rpm) {
 	static char rpmBuffer[_MAX_FILLER];
 	itoa10(rpmBuffer, rpm);
+	return rpmBuffer;
+}
+
+void addEngineSnifferTdcEvent(int rpm) {
 #if EFI_ENGINE_SNIFFER
 	waveChart.startDataCollection();
 #endif
-	addEngineSnifferEvent(TOP_DEAD_CENTER_MESSAGE, (char* ) rpmBuffer);
+	addEngineSnifferEvent(TOP_DEAD_CENTER_MESSAGE, SnifferEventKind::TopDeadCenter, rpm, rpmMessage(rpm));
 }
 
 void addEngineSnifferLogicAnalyzerEvent(int laIndex, FrontDirection frontDirection) {
 	extern const char *laNames[];
 	const char *name = laNames[laIndex];
 
-	addEngineSnifferEvent(name, frontDirection == FrontDirection::UP ? PROTOCOL_ES_UP : PROTOCOL_ES_DOWN);
+	addEngineSnifferEvent(name, edgeKind(frontDirection), 0, edgeMessage(frontDirection));
 }
 
-void addEngineSnifferCrankEvent(int wheelIndex, int triggerEventIndex, FrontDirection frontDirection) {
-	static const char *crankName[2] = { PROTOCOL_CRANK1, PROTOCOL_CRANK2 };
-
+static const char* crankMessage(int triggerEventIndex, FrontDirection frontDirection) {
 	shaft_signal_msg_index[0] = frontDirection == FrontDirection::UP ? 'u' : 'd';
 	// shaft_signal_msg_index[1] is assigned once and forever in the init method below
 	itoa10(&shaft_signal_msg_index[2], triggerEventIndex);
+	return shaft_signal_msg_index;
+}
+
+void addEngineSnifferCrankEvent(int wheelIndex, int triggerEventIndex, FrontDirection frontDirection) {
+	static const char *crankName[2] = { PROTOCOL_CRANK1, PROTOCOL_CRANK2 };
 
-	addEngineSnifferEvent(crankName[wheelIndex], (char* ) shaft_signal_msg_index);
+	SnifferEventKind kind = frontDirection == FrontDirection::UP ? SnifferEventKind::CrankUp : SnifferEventKind::CrankDown;
+	addEngineSnifferEvent(crankName[wheelIndex], kind, triggerEventIndex, crankMessage(triggerEventIndex, frontDirection));
 }
 
 void addEngineSnifferVvtEvent(int vvtIndex, FrontDirection frontDirection) {
 	extern const char *vvtNames[];
 	const char *vvtName = vvtNames[vvtIndex];
 
-	addEngineSnifferEvent(vvtName, frontDirection == FrontDirection::UP ? PROTOCOL_ES_UP : PROTOCOL_ES_DOWN);
+	addEngineSnifferEvent(vvtName, edgeKind(frontDirection), 0, edgeMessage(frontDirection));
 }
@@ -11,12 +11,40 @@
 #include "rusefi_enums.h"
 
 #include "datalogging.h"
+#include "big_buffer.h"
+
+#if EFI_UNIT_TEST
+#include <string>
+#endif
 
 enum class FrontDirection : uint8_t {
 	UP,
 	DOWN
 };
 
+enum class SnifferEventKind : uint8_t {
+	Up,
+	Down,
+	// value is tooth index
+	CrankUp,
+	CrankDown,
+	// value is rpm
+	TopDeadCenter,
+};
+
+/**
+ * Binary sniffer record, text is only produced once the chart is published
+ */
+struct SnifferEvent {
+	uint8_t channel;
+	SnifferEventKind kind;
+	uint16_t value;
+	// since previous event of the same chart
+	uint32_t deltaNt;
+};
+
+static_assert(sizeof(SnifferEvent) == 8);
+
 void addEngineSnifferTdcEvent(int rpm);
 void addEngineSnifferLogicAnalyzerEvent(int laIndex, FrontDirection frontDirection);
 /**
@@ -37,6 +65,15 @@ public:
 	WaveChart();
 	void init();
 	void addEvent3(const char *name, const char *msg);
+	/**
+	 * Binary mode records fixed size events into a big buffer partition, publish() turns them into the same text.
+	 * Chart size is limited by engineChartSize and by the partition
+	 */
+	void setBinaryMode(bool value);
+	bool isBinaryMode() const {
+		return events != nullptr;
+	}
+	void addBinaryEvent(const char *name, SnifferEventKind kind, uint16_t value);
 	void reset();
 	void startDataCollection();
 	void publishIfFull();
@@ -46,8 +83,18 @@ public:
 	// looks like this is only used by functional tests on real hardware
 	efitick_t pauseEngineSnifferUntilNt = 0;
 	int getSize();
+#if EFI_UNIT_TEST
+	// text of last published chart, all pieces of it
+	const char* getChartText() const {
+		return publishedText.c_str();
+	}
+#endif
 
 private:
+	bool acceptsEvents(efitick_t nowNt) const;
+	void publishBinaryEvents();
+	void schedulePiece(bool isFirstPiece, bool isLastPiece);
+
 	Logging logging;
 	char timeBuffer[_MAX_FILLER + 2];
 	// current number of events in buffer, see getSize()
@@ -59,6 +106,17 @@ private:
 	bool collectingData = false;
 	efitick_t startTimeNt = 0;
 	volatile int isInitialized = false;
+
+	BigBufferHandle eventsBuffer;
+	SnifferEvent* events = nullptr;
+	uint32_t eventsCapacity = 0;
+	// ring positions of next event to write and of the first event of current chart
+	uint32_t writePosition = 0;
+	uint32_t chartStartPosition = 0;
+	efitick_t lastEventNt = 0;
+#if EFI_UNIT_TEST
+	std::string publishedText;
+#endif
 };
 
 void initWaveChart(WaveChart *chart);
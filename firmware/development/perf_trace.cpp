@@ -8,6 +8,8 @@
 
 #include "pch.h"
 
+#include <algorithm>
+
 #ifndef ENABLE_PERF_TRACE
 #error ENABLE_PERF_TRACE must be defined!
 #endif
@@ -32,17 +34,37 @@ struct TraceEntry
 // Ensure that the struct is the size we think it is - the binary layout is important
 static_assert(sizeof(TraceEntry) == 8);
 
-#define TRACE_BUFFER_LENGTH (BIG_BUFFER_SIZE / sizeof(TraceEntry))
+// Perf trace takes whatever is free in the big buffer, tooth logger is evicted if that's less than this
+#define TRACE_MIN_BUFFER_SIZE (BIG_BUFFER_SIZE / 4)
+
+// once triggered, ring trace records this many more events before it freezes
+#define POST_TRIGGER_LENGTH (s_traceLength / 8)
 
 // This buffer stores a trace - we write the full buffer once, then disable tracing
 static BigBufferHandle s_traceBuffer;
+// number of entries in s_traceBuffer
+static size_t s_traceLength = 0;
 static size_t s_nextIdx = 0;
 
 static bool s_isTracing = false;
 
+// Ring mode: keep overwriting oldest events until a trigger fires, see perfTraceEnableRing()
+static bool s_isRingMode = false;
+static bool s_hasWrapped = false;
+static uint8_t s_triggerMask = 0;
+static efidur_t s_latenessThresholdNt = 0;
+// zero while armed, otherwise PerfTraceTrigger which fired
+static uint8_t s_triggerReason = 0;
+static size_t s_postTriggerRemaining = 0;
+
 static void stopTrace() {
 	s_isTracing = false;
 	s_nextIdx = 0;
+
+	s_isRingMode = false;
+	s_hasWrapped = false;
+	s_triggerReason = 0;
+	s_postTriggerRemaining = 0;
 }
 
 static void perfEventImpl(PE event, EPhase phase) {
@@ -73,8 +95,19 @@ static void perfEventImpl(PE event, EPhase phase) {
 		__disable_irq();
 
 		idx = s_nextIdx++;
-		if (s_nextIdx >= TRACE_BUFFER_LENGTH) {
-			stopTrace();
+		if (s_nextIdx >= s_traceLength) {
+			if (s_isRingMode) {
+				// overwrite the oldest events
+				s_nextIdx = 0;
+				s_hasWrapped = true;
+			} else {
+				stopTrace();
+			}
+		}
+
+		if (s_postTriggerRemaining != 0 && --s_postTriggerRemaining == 0) {
+			// Freeze: s_nextIdx is left pointing at the oldest event
+			s_isTracing = false;
 		}
 
 		// Restore previous interrupt state - don't restore if they weren't enabled
@@ -116,20 +149,133 @@ void perfEventInstantGlobal(PE event) {
 	perfEventImpl(event, EPhase::InstantGlobal);
 }
 
-void perfTraceEnable() {
+static void acquireTraceBuffer() {
+	s_isTracing = false;
+	// release previous trace so that its space could be reused
+	s_traceBuffer = {};
+
+	size_t size = getBigBufferLargestFree();
 #if EFI_TOOTH_LOGGER
 	// force release of the buffer if occupied by the tooth logger
-	if (IsToothLoggerEnabled()) {
+	if (size < TRACE_MIN_BUFFER_SIZE && IsToothLoggerEnabled()) {
 		// don't worry, it will be automatically enabled
 		// when the next TS_GET_COMPOSITE_BUFFER_DONE_DIFFERENTLY command arrives
 		DisableToothLogger();
+		size = getBigBufferLargestFree();
 	}
 #endif // EFI_TOOTH_LOGGER
-	s_traceBuffer = getBigBuffer(BigBufferUser::PerfTrace);
+	s_traceBuffer = getBigBuffer(BigBufferUser::PerfTrace, size);
+	s_traceLength = s_traceBuffer.size() / sizeof(TraceEntry);
+}
+
+void perfTraceEnable() {
+	acquireTraceBuffer();
+	stopTrace();
 	s_isTracing = true;
 }
 
+#if ENABLE_PERF_TRACE
+
+void perfTraceEnableRing(uint8_t triggerMask, efidur_t latenessThresholdNt) {
+	acquireTraceBuffer();
+	if (!s_traceBuffer) {
+		return;
+	}
+
+	// zero timestamps mark entries which were never written
+	memset(s_traceBuffer.get<TraceEntry>(), 0, s_traceBuffer.size());
+
+	stopTrace();
+	s_isRingMode = true;
+	// manual freeze is always allowed
+	s_triggerMask = triggerMask | static_cast<uint8_t>(PerfTraceTrigger::Manual);
+	s_latenessThresholdNt = latenessThresholdNt;
+	s_isTracing = true;
+}
+
+void perfTraceTrigger(PerfTraceTrigger reason) {
+	// cheap checks first, this is invoked from hot paths
+	if (!s_isRingMode || !(s_triggerMask & static_cast<uint8_t>(reason))) {
+		return;
+	}
+
+	{
+		uint32_t prim = __get_PRIMASK();
+		__disable_irq();
+
+		// only the first anomaly counts, the rest is recorded as part of post-trigger window
+		bool isArmed = s_isRingMode && s_isTracing && s_triggerReason == 0;
+		if (isArmed) {
+			s_triggerReason = static_cast<uint8_t>(reason);
+			s_postTriggerRemaining = POST_TRIGGER_LENGTH;
+		}
+
+		if (!prim) {
+			__enable_irq();
+		}
+
+		if (!isArmed) {
+			return;
+		}
+	}
+
+	// mark the trigger point in the trace
+	perfEventInstantGlobal(PE::PerfTraceTriggered);
+}
+
+void perfTraceOnSchedulerLateness(efidur_t latenessNt) {
+	if (s_isRingMode && latenessNt > s_latenessThresholdNt) {
+		perfTraceTrigger(PerfTraceTrigger::SchedulerLate);
+	}
+}
+
+static void printPerfTraceStatus() {
+	if (!s_isRingMode) {
+		efiPrintf("perf trace ring: off");
+		return;
+	}
+
+	efiPrintf("perf trace ring: mask %d lateness threshold %dus", s_triggerMask, (int)NT2US(s_latenessThresholdNt));
+
+	if (s_triggerReason == 0) {
+		efiPrintf("armed%s", s_hasWrapped ? ", buffer full" : "");
+		return;
+	}
+
+	if (s_isTracing) {
+		efiPrintf("triggered by %d, %d events to go", s_triggerReason, s_postTriggerRemaining);
+		return;
+	}
+
+	const TraceEntry* entries = s_traceBuffer.get<TraceEntry>();
+	size_t oldest = s_hasWrapped ? s_nextIdx : 0;
+	size_t newest = (s_nextIdx + s_traceLength - 1) % s_traceLength;
+	uint32_t windowNt = entries[newest].Timestamp - entries[oldest].Timestamp;
+	efiPrintf("frozen after trigger %d, %.2fms of history", s_triggerReason, NT2US(windowNt) / 1000.0f);
+}
+
+void initPerfTrace() {
+	addConsoleActionII("perftrace_ring", [](int triggerMask, int latenessUs) {
+		perfTraceEnableRing(triggerMask, US2NT(latenessUs));
+		printPerfTraceStatus();
+	});
+	addConsoleAction("perftrace_freeze", []() {
+		perfTraceTrigger(PerfTraceTrigger::Manual);
+	});
+	addConsoleAction("perftrace_status", printPerfTraceStatus);
+}
+
+#endif // ENABLE_PERF_TRACE
+
 const BigBufferHandle perfTraceGetBuffer() {
+	if (s_isRingMode && s_hasWrapped && s_traceBuffer) {
+		s_isTracing = false;
+
+		// put the oldest event first, the tool expects chronological order
+		TraceEntry* entries = s_traceBuffer.get<TraceEntry>();
+		std::rotate(entries, entries + s_nextIdx, entries + s_traceLength);
+	}
+
 	// stop tracing if you try to get the buffer early
 	stopTrace();
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "big_buffer.h"
+#include "rusefi_types.h"
 
 #include <cstdint>
 #include <cstddef>
@@ -74,6 +75,7 @@ enum class PE : uint8_t {
 	LuaAllCanRxFunction,
 	LuaOneCanRxCallback,
   LuaOneCanTxFunction,
+	PerfTraceTriggered,
 	// enum_end_tag
 	// The tag above is consumed by PerfTraceTool.java
 	// please note that the tool requires a comma at the end of last value
@@ -89,6 +91,25 @@ void perfTraceEnable();
 // Retrieve the trace buffer
 const BigBufferHandle perfTraceGetBuffer();
 
+// Conditions which freeze continuous trace, bit mask
+enum class PerfTraceTrigger : uint8_t {
+	SyncLoss = 1,
+	SchedulerLate = 2,
+	FirmwareError = 4,
+	Manual = 8,
+};
+
+#if ENABLE_PERF_TRACE
+// Trace continuously overwriting oldest events until one of triggers fires, then record a bit more and freeze
+void perfTraceEnableRing(uint8_t triggerMask, efidur_t latenessThresholdNt);
+void perfTraceTrigger(PerfTraceTrigger reason);
+void perfTraceOnSchedulerLateness(efidur_t latenessNt);
+void initPerfTrace();
+#else
+inline void perfTraceTrigger(PerfTraceTrigger) { }
+inline void perfTraceOnSchedulerLateness(efidur_t) { }
+#endif /* ENABLE_PERF_TRACE */
+
 #if ENABLE_PERF_TRACE
 class ScopePerf
 {
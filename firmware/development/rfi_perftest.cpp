@@ -247,11 +247,44 @@ static void testMath(const int count) {
 	}
 }
 
+static void testTriggerSyncGap(const int count) {
+	const TriggerWaveform& shape = getTriggerCentral()->triggerShape;
+	if (!shape.isSynchronizationNeeded) {
+		efiPrintf("Current trigger has no sync gap");
+		return;
+	}
+	float from = shape.synchronizationRatioFrom[0];
+	float to = shape.synchronizationRatioTo[0];
+
+	int matches = 0;
+	uint32_t start = getTimeNowLowerNt();
+	for (int i = 0; i < count; i++) {
+		uint32_t current = 1000 + (i & 0xFFF);
+		if (current > 1000 * from && current < 1000 * to) {
+			matches++;
+		}
+	}
+	uint32_t floatTicks = getTimeNowLowerNt() - start;
+
+	start = getTimeNowLowerNt();
+	for (int i = 0; i < count; i++) {
+		uint32_t current = 1000 + (i & 0xFFF);
+		if (shape.isSyncGapInRange(0, current, 1000)) {
+			matches--;
+		}
+	}
+	uint32_t fixedTicks = getTimeNowLowerNt() - start;
+
+	efiPrintf("Finished %d sync gap checks: float %d ticks, fixed point %d ticks, mismatch=%d",
+			count, (int)floatTicks, (int)fixedTicks, matches);
+}
+
 static void runTests(const int count) {
 	efiPrintf("Running tests: %d", count);
 	testRusefiMethods(count / 10);
 	testSystemCalls(count);
 	testMath(count);
+	testTriggerSyncGap(count);
 }
 
 extern Overflow64Counter halTime;
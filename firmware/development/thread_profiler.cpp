@@ -0,0 +1,116 @@
+/**
+ * @file thread_profiler.cpp
+ *
+ * CPU time is accounted in the context switch hook: cycles between two switches belong to the
+ * thread which was running, minus whatever ISRs took meanwhile. Loads are sampled over one second
+ * windows, that's well within 32 bit cycle counter wrap around even on fastest MCUs we have.
+ *
+ * Stack high water marks come from CH_DBG_FILL_THREADS pattern, see CountFreeStackSpace()
+ */
+
+#include "pch.h"
+
+#if EFI_THREAD_PROFILER
+
+#include "thread_profiler.h"
+
+#if !CH_DBG_THREADS_PROFILING || !CH_DBG_FILL_THREADS
+#error EFI_THREAD_PROFILER requires CH_DBG_THREADS_PROFILING and CH_DBG_FILL_THREADS
+#endif
+
+// current thread time slice
+static uint32_t sliceStartNt;
+static uint32_t sliceIsrNt;
+
+static uint8_t isrDepth;
+static uint32_t isrStartNt;
+static uint32_t isrTotalNt;
+
+static uint32_t isrSampleNt;
+static uint32_t windowStartNt;
+static Timer windowTimer;
+
+static uint8_t isrLoadPercent;
+static uint16_t totalMissedDeadlines;
+
+void threadProfilerOnContextSwitch(thread_t* otp) {
+	uint32_t nowNt = getTimeNowLowerNt();
+	otp->cpuTimeNt += nowNt - sliceStartNt - sliceIsrNt;
+
+	sliceStartNt = nowNt;
+	sliceIsrNt = 0;
+}
+
+void threadProfilerOnIrqEnter() {
+	// nested ISR is accounted as part of outer one
+	if (isrDepth++ == 0) {
+		isrStartNt = getTimeNowLowerNt();
+	}
+}
+
+void threadProfilerOnIrqExit() {
+	if (--isrDepth == 0) {
+		uint32_t durationNt = getTimeNowLowerNt() - isrStartNt;
+		sliceIsrNt += durationNt;
+		isrTotalNt += durationNt;
+	}
+}
+
+void onPeriodicControllerDeadlineMissed() {
+	chThdGetSelfX()->missedDeadlines++;
+	totalMissedDeadlines++;
+}
+
+static uint8_t toLoadPercent(uint32_t deltaNt, uint32_t windowNt) {
+	return minI(100, (uint64_t)deltaNt * 100 / windowNt);
+}
+
+void updateThreadProfiler() {
+	if (!windowTimer.hasElapsedSec(1)) {
+		return;
+	}
+	windowTimer.reset();
+
+	uint32_t nowNt = getTimeNowLowerNt();
+	uint32_t windowNt = nowNt - windowStartNt;
+	windowStartNt = nowNt;
+
+	uint32_t isrNt = isrTotalNt;
+	isrLoadPercent = toLoadPercent(isrNt - isrSampleNt, windowNt);
+	isrSampleNt = isrNt;
+
+	thread_t* idle = chSysGetIdleThreadX();
+	int idlePercent = 100;
+	int minFreeStack = INT32_MAX;
+
+	for (thread_t* tp = chRegFirstThread(); tp; tp = chRegNextThread(tp)) {
+		uint32_t cpuTimeNt = tp->cpuTimeNt;
+		tp->cpuLoadPercent = toLoadPercent(cpuTimeNt - tp->cpuTimeSampleNt, windowNt);
+		tp->cpuTimeSampleNt = cpuTimeNt;
+
+		if (tp == idle) {
+			idlePercent = tp->cpuLoadPercent;
+		} else {
+			// idle thread stack is tiny by design, no point reporting it
+			minFreeStack = minI(minFreeStack, CountFreeStackSpace(tp->wabase));
+		}
+	}
+
+	engine->outputChannels.cpuLoad = maxI(0, 100 - idlePercent);
+	engine->outputChannels.isrLoad = isrLoadPercent;
+	engine->outputChannels.threadsMinFreeStack = minI(minFreeStack, UINT16_MAX);
+	engine->outputChannels.periodicDeadlineMisses = totalMissedDeadlines;
+}
+
+void printThreadProfiler() {
+	efiPrintf("name\tload %%\tfree stack\tmissed deadlines");
+
+	for (thread_t* tp = chRegFirstThread(); tp; tp = chRegNextThread(tp)) {
+		efiPrintf("%s\t%d\t%d\t%d", tp->name, tp->cpuLoadPercent, CountFreeStackSpace(tp->wabase), tp->missedDeadlines);
+	}
+
+	efiPrintf("isr\t%d", isrLoadPercent);
+	efiPrintf("total load %d%%, %d missed deadlines", engine->outputChannels.cpuLoad, totalMissedDeadlines);
+}
+
+#endif // EFI_THREAD_PROFILER
@@ -0,0 +1,29 @@
+/**
+ * @file thread_profiler.h
+ *
+ * Per-thread and ISR CPU load, stack high water marks and periodic controller deadline misses.
+ * See "cpuload" console command and cpuLoad/isrLoad output channels.
+ */
+
+#pragma once
+
+#if EFI_THREAD_PROFILER
+
+// Invoked from ChibiOS kernel hooks, see chconf_common.h
+void threadProfilerOnContextSwitch(thread_t* otp);
+void threadProfilerOnIrqEnter();
+void threadProfilerOnIrqExit();
+
+void onPeriodicControllerDeadlineMissed();
+
+/**
+ * Updates loads once per second and publishes them to output channels
+ */
+void updateThreadProfiler();
+void printThreadProfiler();
+
+#else
+
+inline void onPeriodicControllerDeadlineMissed() { }
+
+#endif // EFI_THREAD_PROFILER
@@ -34,5 +34,6 @@ HW_LAYER_DRIVERS_CPP = \
 	$(DRIVERS_DIR)/gpio/tle9201.cpp \
 	$(DRIVERS_DIR)/gpio/l9779.cpp \
 	$(DRIVERS_DIR)/gpio/protected_gpio.cpp \
+	$(DRIVERS_DIR)/gpio/spi_bus_scheduler.cpp \
 	$(DRIVERS_DIR)/sent/sent_hw_icu.cpp \
 	$(DRIVERS_DIR)/led/WS2812.cpp
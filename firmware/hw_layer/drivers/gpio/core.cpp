@@ -9,6 +9,7 @@
 #include "pch.h"
 #include "gpio/gpio_ext.h"
 #include "smart_gpio.h"
+#include "gpio/spi_bus_scheduler.h"
 
 #define STRING2(x) #x
 #define STRING(x) STRING2(x)
@@ -422,6 +423,10 @@ void gpiochips_debug(void)
 		efiPrintf("%s (base %d, size %d):\n", chip->name, (int)chip->base, chip->size);
 		chip->chip->debug();
 	}
+
+#if EFI_PROD_CODE && HAL_USE_SPI
+	spiBusScheduler_printStats();
+#endif
 }
 
 #if EFI_PROD_CODE
@@ -16,6 +16,7 @@
 
 #include "gpio/gpio_ext.h"
 #include "gpio/drv8860.h"
+#include "gpio/spi_bus_scheduler.h"
 
 #if EFI_PROD_CODE && (BOARD_DRV8860_COUNT > 0)
 
@@ -25,8 +26,6 @@
 
 #define DRIVER_NAME				"drv8860"
 
-static bool drv_task_ready = false;
-
 typedef enum {
 	DRV8860_DISABLED = 0,
 	DRV8860_WAIT_INIT,
@@ -42,24 +41,22 @@ typedef enum {
 /* Driver local variables and types.										*/
 /*==========================================================================*/
 
-/* OS */
-SEMAPHORE_DECL(drv8860_wake, 10 /* or BOARD_DRV8860_COUNT ? */);
-static THD_WORKING_AREA(drv8860_thread_1_wa, 256);
-
 /* Driver */
-struct Drv8860 : public GpioChip {
+struct Drv8860 : public GpioChip, public SpiBusClient {
 	int init() override;
 
 	int writePad(size_t pin, int value) override;
 	brain_pin_diag_e getDiag(size_t pin) override;
 
+	/* serviced by shared SPI bus thread */
+	int spiBusUpdateOutputs() override;
+
 	// Internal helpers
 	int chip_init();
 
 	void spi_send(uint16_t tx);
 
 	void update_outputs();
-	int wake_driver();
 
 	const drv8860_config		*cfg;
 	/* cached output state - state last send to chip */
@@ -135,48 +132,19 @@ int Drv8860::chip_init() {
 	return 0;
 }
 
-/**
- * @brief DRV8860 chip driver wakeup.
- * @details Wake up driver. Will cause output register update.
- */
-
-int Drv8860::wake_driver() {
-	/* Entering a reentrant critical zone.*/
-	chibios_rt::CriticalSectionLocker csl;
-
-	chSemSignalI(&drv8860_wake);
-
-	return 0;
-}
-
 /*==========================================================================*/
 /* Driver thread.															*/
 /*==========================================================================*/
 
-static THD_FUNCTION(drv8860_driver_thread, p) {
-	int i;
-	msg_t msg;
-
-	(void)p;
-
-	chRegSetThreadName(DRIVER_NAME);
+/* Driver has no own thread, see spi_bus_scheduler.cpp */
 
-	while (1) {
-		msg = chSemWaitTimeout(&drv8860_wake, TIME_MS2I(DRV8860_POLL_INTERVAL_MS));
-
-		/* should we care about msg == MSG_TIMEOUT? */
-		(void)msg;
+int Drv8860::spiBusUpdateOutputs() {
+	if (drv_state != DRV8860_READY)
+		return -1;
 
-		for (i = 0; i < BOARD_DRV8860_COUNT; i++) {
-			auto chip = &chips[i];
-			if ((chip->cfg == NULL) ||
-				(chip->drv_state == DRV8860_DISABLED) ||
-				(chip->drv_state == DRV8860_FAILED))
-				continue;
+	update_outputs();
 
-			chip->update_outputs();
-		}
-	}
+	return 0;
 }
 
 /*==========================================================================*/
@@ -199,7 +167,7 @@ int Drv8860::writePad(size_t pin, int value) {
 	else
 		o_state &= ~(1 << pin);
 	/* TODO: unlock */
-	wake_driver();
+	spiBusScheduler_requestUpdate(*this);
 
 	return 0;
 }
@@ -218,13 +186,7 @@ int Drv8860::init() {
 
 	drv_state = DRV8860_READY;
 
-	if (!drv_task_ready) {
-		chThdCreateStatic(drv8860_thread_1_wa, sizeof(drv8860_thread_1_wa),
-						  PRIO_GPIOCHIP, drv8860_driver_thread, NULL);
-		drv_task_ready = true;
-	}
-
-	return 0;
+	return spiBusScheduler_register(cfg->spi_bus, *this, DRV8860_POLL_INTERVAL_MS);
 }
 
 /**
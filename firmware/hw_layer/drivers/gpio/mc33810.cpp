@@ -22,6 +22,7 @@
 #include "pch.h"
 #include "gpio/gpio_ext.h"
 #include "gpio/mc33810.h"
+#include "gpio/spi_bus_scheduler.h"
 
 #if EFI_PROD_CODE && (BOARD_MC33810_COUNT > 0)
 
@@ -111,18 +112,16 @@ typedef enum {
 /* Driver local variables and types.										*/
 /*==========================================================================*/
 
-/* OS */
-static thread_t *mc33810_thread = NULL;
-SEMAPHORE_DECL(mc33810_wake, 10 /* or BOARD_MC33810_COUNT ? */);
-static THD_WORKING_AREA(mc33810_thread_wa, 256);
-
 /* Driver */
-struct Mc33810 : public GpioChip {
+struct Mc33810 : public GpioChip, public SpiBusClient {
 	int init() override;
 
 	int writePad(size_t pin, int value) override;
 	brain_pin_diag_e getDiag(size_t pin) override;
 
+	/* serviced by shared SPI bus thread */
+	int spiBusUpdateOutputs() override;
+
 	// internal functions
 	int spi_unselect();
 	int spi_rw(uint16_t tx, uint16_t* rx);
@@ -130,7 +129,6 @@ struct Mc33810 : public GpioChip {
 	int update_output_and_diag();
 
 	int chip_init();
-	void wake_driver();
 
 	int chip_init_data();
 
@@ -167,6 +165,8 @@ struct Mc33810 : public GpioChip {
 	int 					lv_cnt;
 
 	mc33810_drv_state		drv_state;
+	/* when init() was called, first chip_init() waits for supply, see spiBusUpdateOutputs() */
+	efitick_t				init_requested_nt;
 
 	bool hadSuccessfulInit = false;
 };
@@ -590,74 +590,46 @@ err_exit:
 	return ret;
 }
 
-/**
- * @brief MC33810 chip driver wakeup.
- * @details Wake up driver. Will cause output register and
- * diagnostic update.
- */
-
-void Mc33810::wake_driver()
-{
-	/* Entering a reentrant critical zone.*/
-	chibios_rt::CriticalSectionLocker csl;
-	chSemSignalI(&mc33810_wake);
-	if (!port_is_isr_context()) {
-		/**
-		 * chSemSignalI above requires rescheduling
-		 * interrupt handlers have implicit rescheduling
-		 */
-		chSchRescheduleS();
-	}
-}
-
 /*==========================================================================*/
 /* Driver thread.															*/
 /*==========================================================================*/
 
-static THD_FUNCTION(mc33810_driver_thread, p) {
-	(void)p;
-
-	chRegSetThreadName(DRIVER_NAME);
-
-	chThdSleepMilliseconds(2); // let's wait BatteryVoltage to appear. TODO: more proper way of synchronization with BatteryVoltage!
-
+/* Driver has no own thread, see spi_bus_scheduler.cpp */
 
-	while (true) {
-		msg_t msg = chSemWaitTimeout(&mc33810_wake, TIME_MS2I(MC33810_POLL_INTERVAL_MS));
-
-		/* should we care about msg == MSG_TIMEOUT? */
-		(void)msg;
-
-		for (int i = 0; i < BOARD_MC33810_COUNT; i++) {
-			auto chip = &chips[i];
-
-			if (i == 0) {
-					engine->engineState.smartChipRestartCounter = chip->init_cnt;
-					engine->engineState.smartChipAliveCounter = chip->alive_cnt;
-			}
+int Mc33810::spiBusUpdateOutputs() {
+	if (this == &chips[0]) {
+		engine->engineState.smartChipRestartCounter = init_cnt;
+		engine->engineState.smartChipAliveCounter = alive_cnt;
+	}
 
-			if (chip->need_init) {
-				int ret = chip->chip_init();
-				if (ret == 0) {
-					chip->drv_state = MC33810_READY;
-					chip->need_init = false;
-				}
-			}
+	if (need_init) {
+		/* let's wait BatteryVoltage to appear. TODO: more proper way of synchronization with BatteryVoltage!
+		 * Sleeps on SPI bus thread, not on the thread which called init() */
+		efidur_t sinceInitNt = getTimeNowNt() - init_requested_nt;
+		if (sinceInitNt < MS2NT(MC33810_INIT_DELAY_MS))
+			chThdSleepMicroseconds(NT2US(MS2NT(MC33810_INIT_DELAY_MS) - sinceInitNt));
+
+		int ret = chip_init();
+		if (ret == 0) {
+			drv_state = MC33810_READY;
+			need_init = false;
+		}
+	}
 
-			if ((chip->cfg == NULL) ||
-				(chip->drv_state == MC33810_DISABLED) ||
-				(chip->drv_state == MC33810_FAILED)) {
-				chip->need_init = true;
-				continue;
-			}
+	if ((cfg == NULL) ||
+		(drv_state == MC33810_DISABLED) ||
+		(drv_state == MC33810_FAILED)) {
+		need_init = true;
+		return -1;
+	}
 
-			/* TODO: implement indirect driven gpios */
-			int ret = chip->update_output_and_diag();
-			if (ret) {
-				/* set state to MC33810_FAILED? */
-			}
-		}
+	/* TODO: implement indirect driven gpios */
+	int ret = update_output_and_diag();
+	if (ret) {
+		/* set state to MC33810_FAILED? */
 	}
+
+	return ret;
 }
 
 /*==========================================================================*/
@@ -701,7 +673,7 @@ int Mc33810::writePad(size_t pin, int value) {
 						 PAL_PORT_BIT(cfg->direct_io[pin].pad));
 		}
 	} else {
-		wake_driver();
+		spiBusScheduler_requestUpdate(*this);
 	}
 
 	return 0;
@@ -768,18 +740,14 @@ int Mc33810::init() {
 	if (ret)
 		return ret;
 
-	/* force init from driver thread */
+	/* force init from SPI bus thread */
 	need_init = true;
+	init_requested_nt = getTimeNowNt();
 
 	/* instance is ready */
 	drv_state = MC33810_READY;
 
-	if (!mc33810_thread) {
-		mc33810_thread = chThdCreateStatic(mc33810_thread_wa, sizeof(mc33810_thread_wa),
-										   PRIO_GPIOCHIP, mc33810_driver_thread, nullptr);
-	}
-
-	return 0;
+	return spiBusScheduler_register(cfg->spi_bus, *this, MC33810_POLL_INTERVAL_MS);
 }
 
 /**
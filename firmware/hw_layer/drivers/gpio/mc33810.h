@@ -21,6 +21,8 @@
 
 /* TODO: add irq support */
 #define MC33810_POLL_INTERVAL_MS	100
+/* delay between init() and first chip configuration */
+#define MC33810_INIT_DELAY_MS		2
 
 struct mc33810_config {
 #if HAL_USE_SPI
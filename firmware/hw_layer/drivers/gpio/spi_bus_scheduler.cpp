@@ -0,0 +1,234 @@
+/*
+ * @file spi_bus_scheduler.cpp
+ *
+ * Shared SPI bus service for smart GPIO chips, see spi_bus_scheduler.h
+ *
+ * Chips use different chip selects and SPI configurations so a single chained transaction
+ * across chips is not possible. What we do is make sure all pending updates on a bus
+ * go out in one burst: one thread wakeup per bus instead of one per chip per pin change.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "gpio/spi_bus_scheduler.h"
+#include "thread_controller.h"
+
+#if EFI_PROD_CODE && HAL_USE_SPI
+
+/*==========================================================================*/
+/* Local definitions.														*/
+/*==========================================================================*/
+
+#define DRIVER_NAME				"spi_bus"
+
+/*==========================================================================*/
+/* Local variables and types.												*/
+/*==========================================================================*/
+
+class SpiBusWorker : public ThreadController<256> {
+public:
+	SpiBusWorker() : ThreadController(DRIVER_NAME, PRIO_GPIOCHIP) {
+	}
+
+	void wake();
+	void printStats(int index);
+
+	SPIDriver					*spi = nullptr;
+	SpiBusClient				*clients = nullptr;
+	binary_semaphore_t			wakeSem;
+	sysinterval_t				pollInterval = TIME_INFINITE;
+	efidur_t					pollIntervalNt = 0;
+
+protected:
+	void ThreadTask() override;
+
+private:
+	void flushPending();
+	void pollAll();
+
+	efitick_t					lastPollNt = 0;
+
+	/* statistics */
+	uint32_t					requestCnt = 0;
+	uint32_t					updateCnt = 0;
+	uint32_t					wakeupCnt = 0;
+	efidur_t					maxLatencyNt = 0;
+	efidur_t					busyNt = 0;
+	efitick_t					statsStartNt = 0;
+
+	friend void spiBusScheduler_requestUpdate(SpiBusClient& client);
+};
+
+static SpiBusWorker buses[SPI_BUS_SCHEDULER_COUNT];
+
+/*==========================================================================*/
+/* Local functions.															*/
+/*==========================================================================*/
+
+void SpiBusWorker::wake() {
+	/* Entering a reentrant critical zone.*/
+	chibios_rt::CriticalSectionLocker csl;
+
+	chBSemSignalI(&wakeSem);
+	if (!port_is_isr_context()) {
+		/**
+		 * chBSemSignalI above requires rescheduling
+		 * interrupt handlers have implicit rescheduling
+		 */
+		chSchRescheduleS();
+	}
+}
+
+void SpiBusWorker::flushPending() {
+	for (SpiBusClient *client = clients; client; client = client->nextClient) {
+		efitick_t requestedNt;
+
+		{
+			chibios_rt::CriticalSectionLocker csl;
+
+			if (!client->updatePending)
+				continue;
+			/* clear before update so writePad during SPI transfer triggers one more update */
+			client->updatePending = false;
+			requestedNt = client->updateRequestedNt;
+		}
+
+		client->spiBusUpdateOutputs();
+		updateCnt++;
+
+		efidur_t latencyNt = getTimeNowNt() - requestedNt;
+		if (latencyNt > maxLatencyNt)
+			maxLatencyNt = latencyNt;
+	}
+}
+
+void SpiBusWorker::pollAll() {
+	for (SpiBusClient *client = clients; client; client = client->nextClient) {
+		{
+			chibios_rt::CriticalSectionLocker csl;
+			/* poll updates outputs too */
+			client->updatePending = false;
+		}
+
+		client->spiBusPoll();
+	}
+}
+
+void SpiBusWorker::ThreadTask() {
+	statsStartNt = lastPollNt = getTimeNowNt();
+
+	while (true) {
+		msg_t msg = chBSemWaitTimeout(&wakeSem, pollInterval);
+
+		efitick_t startNt = getTimeNowNt();
+
+		if (msg == MSG_OK) {
+			wakeupCnt++;
+			flushPending();
+		}
+
+		if (startNt - lastPollNt >= pollIntervalNt) {
+			lastPollNt = startNt;
+			pollAll();
+		}
+
+		busyNt += getTimeNowNt() - startNt;
+	}
+}
+
+void SpiBusWorker::printStats(int index) {
+	efitick_t nowNt = getTimeNowNt();
+	efidur_t windowNt = nowNt - statsStartNt;
+	float utilization = windowNt > 0 ? 100.0f * busyNt / windowNt : 0;
+
+	efiPrintf(DRIVER_NAME "%d: requests=%lu wakeups=%lu updates=%lu maxLatency=%luus utilization=%.2f%%",
+		index, requestCnt, wakeupCnt, updateCnt,
+		(uint32_t)NT2US(maxLatencyNt), utilization);
+
+	/* start new statistics window, requestCnt is updated from ISR too */
+	chibios_rt::CriticalSectionLocker csl;
+	requestCnt = wakeupCnt = updateCnt = 0;
+	maxLatencyNt = busyNt = 0;
+	statsStartNt = nowNt;
+}
+
+/*==========================================================================*/
+/* Exported functions.														*/
+/*==========================================================================*/
+
+int spiBusScheduler_register(SPIDriver *spi, SpiBusClient& client, int pollIntervalMs) {
+	SpiBusWorker *bus = nullptr;
+
+	if (!spi)
+		return -1;
+
+	for (int i = 0; i < SPI_BUS_SCHEDULER_COUNT; i++) {
+		if ((buses[i].spi == spi) || (buses[i].spi == nullptr)) {
+			bus = &buses[i];
+			break;
+		}
+	}
+
+	if (!bus) {
+		criticalError("Too many SPI buses with smart GPIO chips");
+		return -1;
+	}
+
+	{
+		chibios_rt::CriticalSectionLocker csl;
+
+		if (bus->spi == nullptr) {
+			bus->spi = spi;
+			chBSemObjectInit(&bus->wakeSem, true);
+		}
+
+		client.spiBus = bus;
+		client.nextClient = bus->clients;
+		bus->clients = &client;
+
+		/* bus is polled as often as most demanding chip needs */
+		sysinterval_t interval = TIME_MS2I(pollIntervalMs);
+		if ((bus->pollInterval == TIME_INFINITE) || (interval < bus->pollInterval)) {
+			bus->pollInterval = interval;
+			bus->pollIntervalNt = MS2NT(pollIntervalMs);
+		}
+	}
+
+	bus->start();
+
+	return 0;
+}
+
+void spiBusScheduler_requestUpdate(SpiBusClient& client) {
+	SpiBusWorker *bus = client.spiBus;
+
+	/* not registered yet */
+	if (!bus)
+		return;
+
+	{
+		/* Entering a reentrant critical zone.*/
+		chibios_rt::CriticalSectionLocker csl;
+
+		bus->requestCnt++;
+		if (client.updatePending) {
+			/* coalesced with update which is already pending */
+			return;
+		}
+		client.updatePending = true;
+		client.updateRequestedNt = getTimeNowNt();
+	}
+
+	bus->wake();
+}
+
+void spiBusScheduler_printStats() {
+	for (int i = 0; i < SPI_BUS_SCHEDULER_COUNT; i++) {
+		if (buses[i].spi)
+			buses[i].printStats(i);
+	}
+}
+
+#endif /* EFI_PROD_CODE && HAL_USE_SPI */
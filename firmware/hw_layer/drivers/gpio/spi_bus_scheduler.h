@@ -0,0 +1,45 @@
+/*
+ * @file spi_bus_scheduler.h
+ *
+ * Shared SPI bus service for smart GPIO chips
+ *
+ * All chips sitting on the same SPI bus are serviced by one thread: output updates
+ * requested by writePad() of any chip on the bus are coalesced and flushed back to back
+ * on a single wakeup instead of each driver waking its own thread.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "gpio/gpio_ext.h"
+
+#if EFI_PROD_CODE && HAL_USE_SPI
+
+#ifndef SPI_BUS_SCHEDULER_COUNT
+#define SPI_BUS_SCHEDULER_COUNT		2
+#endif
+
+class SpiBusWorker;
+
+struct SpiBusClient {
+	/* push output state to the chip, invoked from bus thread only */
+	virtual int spiBusUpdateOutputs() = 0;
+	/* periodic housekeeping: diagnostic, reinit. Invoked from bus thread only */
+	virtual void spiBusPoll() { spiBusUpdateOutputs(); }
+
+	/* owned by bus scheduler */
+	SpiBusWorker				*spiBus = nullptr;
+	SpiBusClient				*nextClient = nullptr;
+	volatile bool				updatePending = false;
+	efitick_t					updateRequestedNt = 0;
+};
+
+/* should be called from chip init(), starts bus thread on first registration */
+int spiBusScheduler_register(SPIDriver *spi, SpiBusClient& client, int pollIntervalMs);
+/* request output update, can be called from any context including ISR */
+void spiBusScheduler_requestUpdate(SpiBusClient& client);
+
+void spiBusScheduler_printStats();
+
+#endif /* EFI_PROD_CODE && HAL_USE_SPI */
@@ -24,6 +24,7 @@
 
 #include "gpio/gpio_ext.h"
 #include "gpio/tle6240.h"
+#include "gpio/spi_bus_scheduler.h"
 
 #if defined(BOARD_TLE6240_COUNT) && (BOARD_TLE6240_COUNT > 0)
 
@@ -46,8 +47,6 @@
 
 #define DRIVER_NAME				"tle6240"
 
-static bool drv_task_ready = false;
-
 typedef enum {
 	TLE6240_DISABLED = 0,
 	TLE6240_WAIT_INIT,
@@ -76,17 +75,17 @@ typedef enum {
 /* Driver local variables and types.										*/
 /*==========================================================================*/
 
-/* OS */
-SEMAPHORE_DECL(tle6240_wake, 10 /* or BOARD_TLE6240_COUNT ? */);
-static THD_WORKING_AREA(tle6240_thread_1_wa, 256);
-
 /* Driver */
-struct Tle6240 : public GpioChip {
+struct Tle6240 : public GpioChip, public SpiBusClient {
 	int init() override;
 
 	int writePad(size_t pin, int value) override;
 	brain_pin_diag_e getDiag(size_t pin) override;
 
+	/* serviced by shared SPI bus thread */
+	int spiBusUpdateOutputs() override;
+	void spiBusPoll() override;
+
 
 	// internal functions
 	int spi_rw(uint16_t tx, uint16_t *rx);
@@ -302,62 +301,25 @@ err_gpios:
 	return ret;
 }
 
-/**
- * @brief TLE6240 chip driver wakeup.
- * @details Wake up driver. Will cause output register and
- * diagnostic update.
- */
-
-static int tle6240_wake_driver()
-{
-	/* Entering a reentrant critical zone.*/
-	chibios_rt::CriticalSectionLocker csl;
-
-	chSemSignalI(&tle6240_wake);
-	if (!port_is_isr_context()) {
-		/**
-		 * chSemSignalI above requires rescheduling
-		 * interrupt handlers have implicit rescheduling
-		 */
-		chSchRescheduleS();
-	}
-
-	return 0;
-}
-
 /*==========================================================================*/
 /* Driver thread.															*/
 /*==========================================================================*/
 
-static THD_FUNCTION(tle6240_driver_thread, p)
-{
-	int i;
-	msg_t msg;
+/* Driver has no own thread, see spi_bus_scheduler.cpp */
 
-	(void)p;
-
-	chRegSetThreadName(DRIVER_NAME);
-
-	while(1) {
-		msg = chSemWaitTimeout(&tle6240_wake, TIME_MS2I(TLE6240_POLL_INTERVAL_MS));
-
-		/* should we care about msg == MSG_TIMEOUT? */
-		(void)msg;
-
-		for (i = 0; i < BOARD_TLE6240_COUNT; i++) {
-			int ret;
-			Tle6240& chip = chips[i];
+int Tle6240::spiBusUpdateOutputs()
+{
+	if (drv_state != TLE6240_READY)
+		return -1;
 
-			if (!chip.cfg ||
-				(chip.drv_state == TLE6240_DISABLED) ||
-				(chip.drv_state == TLE6240_FAILED))
-				continue;
+	return update_output_and_diag();
+}
 
-			ret = chip.update_output_and_diag();
-			if (ret) {
-				/* set state to TLE6240_FAILED? */
-			}
-		}
+void Tle6240::spiBusPoll()
+{
+	int ret = spiBusUpdateOutputs();
+	if (ret) {
+		/* set state to TLE6240_FAILED? */
 	}
 }
 
@@ -397,7 +359,7 @@ int Tle6240::writePad(unsigned int pin, int value)
 			palClearPort(cfg->direct_io[n].port,
 					   PAL_PORT_BIT(cfg->direct_io[n].pad));
 	} else {
-		tle6240_wake_driver();
+		spiBusScheduler_requestUpdate(*this);
 	}
 
 	return 0;
@@ -433,13 +395,7 @@ int Tle6240::init()
 
 	drv_state = TLE6240_READY;
 
-	if (!drv_task_ready) {
-		chThdCreateStatic(tle6240_thread_1_wa, sizeof(tle6240_thread_1_wa),
-						  PRIO_GPIOCHIP, tle6240_driver_thread, nullptr);
-		drv_task_ready = true;
-	}
-
-	return 0;
+	return spiBusScheduler_register(cfg->spi_bus, *this, TLE6240_POLL_INTERVAL_MS);
 }
 
 /**
@@ -17,7 +17,8 @@
 
 #if EFI_PROD_CODE
 
-#include "periodic_thread_controller.h"
+#include "periodic_executor.h"
+#include "thread_controller.h"
 
 // Just in case we have a mechanism to validate that hardware timer is clocked right and all the
 // conversions between wall clock and hardware frequencies are done right
@@ -93,6 +94,69 @@ void setHardwareSchedulerTimer(efitick_t nowNt, efitick_t setTimeNt) {
 	timerRestartCounter++;
 }
 
+#if EFI_LOW_PRIORITY_SCHEDULER
+/**
+ * Same as setHardwareSchedulerTimer but for the low priority queue. No freeze accounting here:
+ * being a bit late is expected for this queue.
+ */
+void setHardwareLowPrioritySchedulerTimer(efitick_t nowNt, efitick_t setTimeNt) {
+	criticalAssertVoid(hwStarted, "HW.started");
+
+	const auto timeDeltaNt = setTimeNt - nowNt;
+
+	if (timeDeltaNt < US2NT(2)) {
+		setTimeNt = nowNt + US2NT(2);
+	} else if (timeDeltaNt >= TOO_FAR_INTO_FUTURE_NT) {
+		firmwareError(ObdCode::CUSTOM_ERR_TIMER_OVERFLOW, "setHardwareLowPrioritySchedulerTimer() too far");
+		return;
+	}
+
+	if (hasFirmwareError()) {
+		return;
+	}
+
+	portSetHardwareLowPrioritySchedulerTimer(nowNt, setTimeNt);
+}
+
+void globalLowPriorityTimerCallback();
+
+/**
+ * Low priority compare channel shares the interrupt vector (and NVIC priority) with the precise
+ * scheduler channel, so the ISR only wakes this thread. Low priority actions are then executed
+ * from thread context where the precise ISR can preempt them between actions.
+ */
+class LowPrioritySchedulerThread : public ThreadController<UTILITY_THREAD_STACK_SIZE> {
+public:
+	LowPrioritySchedulerThread() : ThreadController("LowPrioSched", PRIO_LOW_PRIORITY_SCHEDULER) {
+		chBSemObjectInit(&m_wakeup, true);
+	}
+
+	void wakeFromIsr() {
+		chSysLockFromISR();
+		chBSemSignalI(&m_wakeup);
+		chSysUnlockFromISR();
+	}
+
+protected:
+	void ThreadTask() override {
+		while (true) {
+			chBSemWait(&m_wakeup);
+
+			globalLowPriorityTimerCallback();
+		}
+	}
+
+private:
+	binary_semaphore_t m_wakeup;
+};
+
+static LowPrioritySchedulerThread lowPrioritySchedulerThread;
+
+void portLowPriorityTimerCallback() {
+	lowPrioritySchedulerThread.wakeFromIsr();
+}
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+
 void globalTimerCallback();
 
 void portMicrosecondTimerCallback() {
@@ -107,9 +171,9 @@ void portMicrosecondTimerCallback() {
 	}
 }
 
-struct MicrosecondTimerWatchdogController : public PeriodicController<256> {
+struct MicrosecondTimerWatchdogController : public PeriodicJob {
 	MicrosecondTimerWatchdogController()
-		: PeriodicController("MstWatchdog", NORMALPRIO, 2)
+		: PeriodicJob("MstWatchdog", PeriodicLane::High, 2)
 	{
 	}
 
@@ -172,6 +236,10 @@ static void validateHardwareTimer() {
 void initMicrosecondTimer() {
 	portInitMicrosecondTimer();
 
+#if EFI_LOW_PRIORITY_SCHEDULER
+	lowPrioritySchedulerThread.start();
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+
 	hwStarted = true;
 
 	lastSetTimerTimeNt = getTimeNowNt();
@@ -9,6 +9,9 @@
 
 void initMicrosecondTimer();
 void setHardwareSchedulerTimer(efitick_t nowNt, efitick_t setTimeNt);
+#if EFI_LOW_PRIORITY_SCHEDULER
+void setHardwareLowPrioritySchedulerTimer(efitick_t nowNt, efitick_t setTimeNt);
+#endif // EFI_LOW_PRIORITY_SCHEDULER
 
 #define TOO_FAR_INTO_FUTURE_MS (10 * MS_PER_SECOND)
 #define TOO_FAR_INTO_FUTURE_US MS2US(TOO_FAR_INTO_FUTURE_MS)
@@ -11,3 +11,9 @@ void portSetHardwareSchedulerTimer(efitick_t nowNt, efitick_t setTimeNt);
 
 // The port should call this callback when the timer expires
 void portMicrosecondTimerCallback();
+
+#if EFI_LOW_PRIORITY_SCHEDULER
+// Second compare channel of the same timebase, dedicated to the low priority queue
+void portSetHardwareLowPrioritySchedulerTimer(efitick_t nowNt, efitick_t setTimeNt);
+void portLowPriorityTimerCallback();
+#endif // EFI_LOW_PRIORITY_SCHEDULER
@@ -35,7 +35,7 @@ extern "C"
  #ifndef __ASSEMBLER__
  void irqEnterHook(void);
  void irqExitHook(void);
- void contextSwitchHook(void);
+ void contextSwitchHook(void* otp);
  void threadInitHook(void* tp);
  void onLockHook(void);
  void onUnlockHook(void);
@@ -74,6 +74,11 @@ extern "C" {
   void *activeStack; \
   int remainingStack; \
   unsigned char threadId; \
+  /* see thread_profiler.cpp */ \
+  unsigned char cpuLoadPercent; \
+  unsigned short missedDeadlines; \
+  unsigned int cpuTimeNt; \
+  unsigned int cpuTimeSampleNt; \
   /* Add threads custom fields here.*/
 
 /**
@@ -92,7 +97,7 @@ extern "C" {
  * @details This hook is invoked just before switching between threads.
  */
 #define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                              \
-  contextSwitchHook();                                                      \
+  contextSwitchHook(otp);                                                   \
 }
 
 /**
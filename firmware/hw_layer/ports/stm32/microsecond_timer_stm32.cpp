@@ -32,6 +32,29 @@ static void hwTimerCallback(PWMDriver*) {
 	portMicrosecondTimerCallback();
 }
 
+#if EFI_LOW_PRIORITY_SCHEDULER
+/**
+ * Low priority queue uses second compare channel of the same timer: same timebase and no extra
+ * hardware timer needed.
+ *
+ * Both channels share the timer interrupt vector and so its NVIC priority, that's why channel 1
+ * interrupt does not run low priority callbacks: it only wakes a thread which executes them, see
+ * portLowPriorityTimerCallback(). Channel 0 compare is served right away even while low priority
+ * callbacks are running.
+ */
+void portSetHardwareLowPrioritySchedulerTimer(efitick_t nowNt, efitick_t setTimeNt) {
+	UNUSED(nowNt);
+
+	pwm_lld_enable_channel(&SCHEDULER_PWM_DEVICE, 1, setTimeNt);
+	pwmEnableChannelNotificationI(&SCHEDULER_PWM_DEVICE, 1);
+}
+
+static void hwLowPriorityTimerCallback(PWMDriver*) {
+	pwmDisableChannelNotificationI(&SCHEDULER_PWM_DEVICE, 1);
+	portLowPriorityTimerCallback();
+}
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+
 static constexpr PWMConfig timerConfig = {
 	.frequency = SCHEDULER_TIMER_FREQ,
 	/* wanted timer period = 2^32 counts,
@@ -41,8 +64,12 @@ static constexpr PWMConfig timerConfig = {
 	.period = 0,
 	.callback = nullptr,		// No update callback
 	.channels = {
-		{PWM_OUTPUT_DISABLED, hwTimerCallback},	// Channel 0 = timer callback, others unused
+		{PWM_OUTPUT_DISABLED, hwTimerCallback},	// Channel 0 = timer callback
+#if EFI_LOW_PRIORITY_SCHEDULER
+		{PWM_OUTPUT_DISABLED, hwLowPriorityTimerCallback},	// Channel 1 = low priority timer callback
+#else
 		{PWM_OUTPUT_DISABLED, nullptr},
+#endif // EFI_LOW_PRIORITY_SCHEDULER
 		{PWM_OUTPUT_DISABLED, nullptr},
 		{PWM_OUTPUT_DISABLED, nullptr}
 	},
@@ -60,7 +87,11 @@ void portInitMicrosecondTimer() {
 	// We want to be able to set the compare register without waiting for an update event
 	// (which would take 358 seconds at 12mhz timer speed), so we have to use normal upcounting
 	// output compare mode instead.
-	SCHEDULER_TIMER_DEVICE->CCMR1 = STM32_TIM_CCMR1_OC1M(1);
+	SCHEDULER_TIMER_DEVICE->CCMR1 = STM32_TIM_CCMR1_OC1M(1)
+#if EFI_LOW_PRIORITY_SCHEDULER
+		| STM32_TIM_CCMR1_OC2M(1)
+#endif // EFI_LOW_PRIORITY_SCHEDULER
+		;
 
 	/* TODO: implement for all possible TIMs */
 	if (SCHEDULER_TIMER_DEVICE == TIM5) {
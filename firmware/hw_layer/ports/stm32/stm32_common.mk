@@ -15,6 +15,7 @@ HW_LAYER_PORT_CPP += \
 	$(HW_STM32_PORT_DIR)/microsecond_timer_stm32.cpp \
 	$(HW_STM32_PORT_DIR)/osc_detector.cpp \
 	$(HW_STM32_PORT_DIR)/flash_int.cpp \
+	$(HW_STM32_PORT_DIR)/stm32_crc.cpp \
 	$(HW_STM32_PORT_DIR)/serial_over_usb/usbcfg.cpp
 
 RUSEFIASM = \
@@ -0,0 +1,72 @@
+/**
+ * @file	stm32_crc.cpp
+ * @brief	CRC32 using CRC calculation unit
+ *
+ * F7 and H7 CRC unit has programmable initial value and input/output bit reversal, that's what it takes
+ * to continue zlib style CRC from any point. F4 unit can do neither so F4 stays with software CRC.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "fast_crc32.h"
+
+#if EFI_HW_CRC32
+
+#if !defined(STM32F7XX) && !defined(STM32H7XX)
+#error "EFI_HW_CRC32 needs F7 or H7 CRC unit"
+#endif
+
+// CRC unit is shared by all threads, this is how long we keep it to ourselves
+#define HW_CRC_CHUNK_SIZE 128
+
+static bool isCrcClockEnabled = false;
+
+static uint32_t hwCrc32Chunk(const uint8_t *data, uint32_t crc, size_t size) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (!isCrcClockEnabled) {
+		rccEnableCRC(true);
+		isCrcClockEnabled = true;
+	}
+
+	// default 32 bit 0x04C11DB7 polynomial, input bit reversal by byte and output bit reversal is zlib CRC
+	CRC->POL = 0x04C11DB7;
+	CRC->CR = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT;
+	// unit works on non-reflected CRC register
+	CRC->INIT = __RBIT(~crc);
+	CRC->CR |= CRC_CR_RESET;
+
+	while (size >= 4) {
+		uint32_t word;
+		memcpy(&word, data, sizeof(word));
+		// first byte in memory has to go first
+		CRC->DR = __REV(word);
+		data += 4;
+		size -= 4;
+	}
+
+	while (size > 0) {
+		*reinterpret_cast<volatile uint8_t *>(&CRC->DR) = *data;
+		data++;
+		size--;
+	}
+
+	return ~CRC->DR;
+}
+
+uint32_t hwCrc32Inc(const void *buf, uint32_t crc, size_t size) {
+	const uint8_t *data = static_cast<const uint8_t *>(buf);
+
+	while (size > 0) {
+		size_t chunkSize = minI(size, HW_CRC_CHUNK_SIZE);
+		crc = hwCrc32Chunk(data, crc, chunkSize);
+		data += chunkSize;
+		size -= chunkSize;
+	}
+
+	return crc;
+}
+
+#endif // EFI_HW_CRC32
@@ -5,5 +5,7 @@
 DDEFS += -DEFI_STORAGE_INT_FLASH=FALSE
 # use higher level API instead
 DDEFS += -DEFI_STORAGE_MFS=TRUE
-# Are we going to store something else but settings?
-DDEFS += -DMFS_CFG_MAX_RECORDS=8 -DMFS_CFG_TRANSACTION_MAX=0
+# Settings are split into up to 32 chunk records starting from ID 16, see storage.h
+# all chunks changed by one burn are written in single transaction
+DDEFS += -DEFI_STORAGE_JOURNAL=TRUE
+DDEFS += -DMFS_CFG_MAX_RECORDS=48 -DMFS_CFG_TRANSACTION_MAX=32
@@ -24,7 +24,7 @@
 #if EFI_ONBOARD_MEMS
 #include "mpu_util.h"
 #include "lis302dl.h"
-#include "periodic_thread_controller.h"
+#include "periodic_executor.h"
 
 #if (EFI_ONBOARD_MEMS_LIS2DW12 == TRUE)
 #include "lis2dw12.h"
@@ -166,9 +166,9 @@ enum AccelType_t {
 
 static AccelType_t AccelType = ACCEL_UNK;
 
-class AccelController : public PeriodicController<UTILITY_THREAD_STACK_SIZE> {
+class AccelController : public PeriodicJob {
 public:
-	AccelController() : PeriodicController("Acc SPI") { }
+	AccelController() : PeriodicJob("Acc SPI", PeriodicLane::Low, 1) { }
 private:
 	void PeriodicTask(efitick_t nowNt) override	{
 		msg_t ret = MSG_RESET;
@@ -1405,9 +1405,32 @@ struct output_channels_s {
 	 */
 	int8_t fuelCutReasonBlinker = (int8_t)0;
 	/**
+	 * CPU load
+	 * units: %
 	 * offset 806
 	 */
-	uint8_t unusedAtTheEnd[52] = {};
+	uint8_t cpuLoad = (uint8_t)0;
+	/**
+	 * ISR load
+	 * units: %
+	 * offset 807
+	 */
+	uint8_t isrLoad = (uint8_t)0;
+	/**
+	 * Min free thread stack
+	 * units: bytes
+	 * offset 808
+	 */
+	uint16_t threadsMinFreeStack = (uint16_t)0;
+	/**
+	 * Periodic deadline misses
+	 * offset 810
+	 */
+	uint16_t periodicDeadlineMisses = (uint16_t)0;
+	/**
+	 * offset 812
+	 */
+	uint8_t unusedAtTheEnd[46] = {};
 	/**
 	 * need 4 byte alignment
 	 * units: units
@@ -0,0 +1,90 @@
+/**
+ * @file	binary_log_format.h
+ *
+ * Layout of binary log records, shared by firmware and misc/binary_log_decoder
+ *
+ * In binary logging mode efiPrintf does not format anything: the record is the address of the format
+ * string followed by raw arguments in the order of format conversions. Integers and floats are 4 bytes
+ * little endian, strings are copied including zero terminator. Host side reads format strings
+ * from firmware ELF and does the formatting.
+ *
+ * This header is used by host tools, do not include anything firmware specific.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define PROTOCOL_BINARY_MSG "binmsg"
+
+enum class LogArgType : uint8_t {
+	Int,
+	Float,
+	String,
+};
+
+struct LogConversion {
+	// points at '%'
+	const char* start;
+	// just past the conversion character
+	const char* end;
+	LogArgType type;
+	// width and/or precision given as '*', each one is an int argument preceding the value
+	uint8_t starCount;
+};
+
+/**
+ * Finds next conversion in printf style format string, "%%" is skipped
+ * @param fmt is moved past the conversion
+ * @return false once there are no more conversions
+ */
+static inline bool nextLogConversion(const char*& fmt, LogConversion& conversion) {
+	while (*fmt) {
+		if (*fmt != '%') {
+			fmt++;
+			continue;
+		}
+
+		const char* start = fmt++;
+		if (*fmt == '%') {
+			fmt++;
+			continue;
+		}
+
+		uint8_t starCount = 0;
+		// flags, width, precision and length modifiers
+		while (*fmt) {
+			char c = *fmt;
+			if (c == '*') {
+				starCount++;
+			} else if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == ' ' || c == '#' || c == '.'
+					|| c == 'l' || c == 'h' || c == 'L' || c == 'z' || c == 'j' || c == 't')) {
+				break;
+			}
+			fmt++;
+		}
+
+		if (!*fmt) {
+			// dangling '%' at the end of format string
+			return false;
+		}
+
+		char c = *fmt++;
+		conversion.start = start;
+		conversion.end = fmt;
+		conversion.starCount = starCount;
+
+		if (c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G') {
+			conversion.type = LogArgType::Float;
+		} else if (c == 's') {
+			conversion.type = LogArgType::String;
+		} else {
+			// d, i, u, x, X, o, c, p and ChibiOS long variants D, U, O
+			conversion.type = LogArgType::Int;
+		}
+
+		return true;
+	}
+
+	return false;
+}
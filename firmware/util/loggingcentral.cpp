@@ -25,6 +25,7 @@
 
 
 #include "thread_controller.h"
+#include "binary_log_format.h"
 
 /* for isprint() */
 #include <ctype.h>
@@ -39,6 +40,22 @@ void LogBuffer<TBufferSize>:: writeLogger(Logging* logging) {
 	writeInternal(logging->buffer);
 }
 
+template <size_t TBufferSize>
+bool LogBuffer<TBufferSize>::tryWriteLogger(Logging* logging) {
+	// leave one byte extra at the end to guarantee room for a null terminator
+	if (logging->loggingSize() > TBufferSize - length() - 1) {
+		return false;
+	}
+	writeInternal(logging->buffer);
+	return true;
+}
+
+template <size_t TBufferSize>
+void LogBuffer<TBufferSize>::truncate(size_t length) {
+	m_writePtr = m_buffer + length;
+	*m_writePtr = '\0';
+}
+
 template <size_t TBufferSize>
 size_t LogBuffer<TBufferSize>::length() const {
 	return m_writePtr - m_buffer;
@@ -156,6 +173,137 @@ public:
 
 static LoggingBufferFlusher lbf;
 
+static void formatTextLine(LogLineBuffer* lineBuffer, const char *format, va_list ap) {
+	size_t len = chvsnprintf(lineBuffer->buffer, sizeof(lineBuffer->buffer), format, ap);
+
+	// Ensure that the string is comma-terminated in case it overflowed
+	lineBuffer->buffer[sizeof(lineBuffer->buffer) - 1] = LOG_DELIMITER[0];
+
+	if (len > sizeof(lineBuffer->buffer) - 1)
+		len = sizeof(lineBuffer->buffer) - 1;
+	for (size_t i = 0; i < len; i++) {
+		/* just replace all non-printable chars with space
+		 * TODO: is there any other "prohibited" chars? */
+		if (isprint(lineBuffer->buffer[i]) == 0)
+			lineBuffer->buffer[i] = ' ';
+	}
+}
+
+#if EFI_BINARY_LOGGING
+
+static bool isBinaryLogging = false;
+
+void setBinaryLogging(bool value) {
+	isBinaryLogging = value;
+	efiPrintf("binary logging %s", boolToString(value));
+}
+
+/**
+ * Hex encodes raw record bytes into the line, so that binary records travel through the usual text log.
+ * Two characters per byte is still way cheaper than formatting numbers, floats especially.
+ */
+class BinaryLineWriter {
+public:
+	BinaryLineWriter(LogLineBuffer* lineBuffer)
+		: m_ptr(lineBuffer->buffer)
+		// room for the closing delimiter and the zero terminator
+		, m_end(lineBuffer->buffer + sizeof(lineBuffer->buffer) - 2)
+	{
+		append(PROTOCOL_BINARY_MSG LOG_DELIMITER);
+	}
+
+	size_t bytesAvailable() const {
+		return (m_end - m_ptr) / 2;
+	}
+
+	void writeByte(uint8_t value) {
+		static const char hexDigits[] = "0123456789abcdef";
+		*m_ptr++ = hexDigits[value >> 4];
+		*m_ptr++ = hexDigits[value & 0xF];
+	}
+
+	bool writeU32(uint32_t value) {
+		if (bytesAvailable() < sizeof(value)) {
+			return false;
+		}
+		for (size_t i = 0; i < sizeof(value); i++) {
+			writeByte(value >> (8 * i));
+		}
+		return true;
+	}
+
+	bool writeString(const char* value) {
+		if (bytesAvailable() < 1) {
+			return false;
+		}
+		if (!value) {
+			value = "(null)";
+		}
+		// truncate long strings, keep room for the terminator
+		while (*value && bytesAvailable() > 1) {
+			writeByte(*value++);
+		}
+		writeByte(0);
+		return true;
+	}
+
+	void finish() {
+		append(LOG_DELIMITER);
+	}
+
+private:
+	void append(const char* text) {
+		while (*text) {
+			*m_ptr++ = *text++;
+		}
+		*m_ptr = '\0';
+	}
+
+	char* m_ptr;
+	char* const m_end;
+};
+
+static void writeBinaryLine(LogLineBuffer* lineBuffer, const char *format, va_list ap) {
+	BinaryLineWriter writer(lineBuffer);
+
+	// format string is identified by its address, host tool looks it up in firmware ELF
+	writer.writeU32(reinterpret_cast<uintptr_t>(format));
+
+	LogConversion conversion;
+	bool hasRoom = true;
+	while (hasRoom && nextLogConversion(format, conversion)) {
+		for (size_t i = 0; hasRoom && i < conversion.starCount; i++) {
+			hasRoom = writer.writeU32(va_arg(ap, int));
+		}
+
+		if (!hasRoom) {
+			break;
+		}
+
+		switch (conversion.type) {
+		case LogArgType::Float: {
+			// varargs promote float to double, but float precision is all we ever had
+			float value = va_arg(ap, double);
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			hasRoom = writer.writeU32(bits);
+			break;
+		}
+		case LogArgType::String:
+			hasRoom = writer.writeString(va_arg(ap, const char*));
+			break;
+		case LogArgType::Int:
+			hasRoom = writer.writeU32(va_arg(ap, uint32_t));
+			break;
+		}
+	}
+
+	// truncated record is decoded as far as it goes
+	writer.finish();
+}
+
+#endif // EFI_BINARY_LOGGING
+
 void startLoggingProcessor() {
 	// Push all buffers in to the free queue
 	for (size_t i = 0; i < lineBufferCount; i++) {
@@ -203,20 +351,15 @@ void efiPrintfInternal(const char *format, ...) {
 	// Write the formatted string to the output buffer
 	va_list ap;
 	va_start(ap, format);
-	size_t len = chvsnprintf(lineBuffer->buffer, sizeof(lineBuffer->buffer), format, ap);
-	va_end(ap);
-
-	// Ensure that the string is comma-terminated in case it overflowed
-	lineBuffer->buffer[sizeof(lineBuffer->buffer) - 1] = LOG_DELIMITER[0];
-
-	if (len > sizeof(lineBuffer->buffer) - 1)
-		len = sizeof(lineBuffer->buffer) - 1;
-	for (size_t i = 0; i < len; i++) {
-		/* just replace all non-printable chars with space
-		 * TODO: is there any other "prohibited" chars? */
-		if (isprint(lineBuffer->buffer[i]) == 0)
-			lineBuffer->buffer[i] = ' ';
+#if EFI_BINARY_LOGGING
+	if (isBinaryLogging) {
+		writeBinaryLine(lineBuffer, format, ap);
+	} else
+#endif // EFI_BINARY_LOGGING
+	{
+		formatTextLine(lineBuffer, format, ap);
 	}
+	va_end(ap);
 
 	{
 		// Push the buffer in to the written list so it can be written back
@@ -247,3 +390,36 @@ void scheduleLogging(Logging *logging) {
 	logging->reset();
 #endif
 }
+
+#if (EFI_PROD_CODE || EFI_SIMULATOR) && EFI_TEXT_LOGGING
+// where current multi-piece message starts in writeBuffer
+static size_t pieceMessageStart;
+static bool isPieceMessageDropped;
+#endif
+
+void scheduleLoggingPiece(Logging *logging, bool isFirstPiece, bool isLastPiece) {
+#if (EFI_PROD_CODE || EFI_SIMULATOR) && EFI_TEXT_LOGGING
+	if (isFirstPiece) {
+		// Inhibit buffer swaps and other writers until the last piece
+		logBufferMutex.lock();
+		pieceMessageStart = writeBuffer->length();
+		isPieceMessageDropped = false;
+	}
+
+	if (!isPieceMessageDropped && !writeBuffer->tryWriteLogger(logging)) {
+		// half a message is worse than none
+		writeBuffer->truncate(pieceMessageStart);
+		isPieceMessageDropped = true;
+	}
+
+	if (isLastPiece) {
+		logBufferMutex.unlock();
+	}
+
+	logging->reset();
+#else
+	UNUSED(logging);
+	UNUSED(isFirstPiece);
+	UNUSED(isLastPiece);
+#endif
+}
@@ -13,6 +13,14 @@ class Logging;
 
 void startLoggingProcessor();
 
+#if EFI_BINARY_LOGGING
+/**
+ * In binary mode efiPrintf sends format string address and raw arguments, see binary_log_format.h
+ * Use misc/binary_log_decoder with matching firmware ELF to turn those into text.
+ */
+void setBinaryLogging(bool value);
+#endif // EFI_BINARY_LOGGING
+
 const char* swapOutputBuffers(size_t *actualOutputBufferSize);
 
 namespace priv
@@ -34,6 +42,12 @@ namespace priv
  * This is the legacy function to copy the contents of a local Logging object in to the output buffer
  */
 void scheduleLogging(Logging *logging);
+/**
+ * Same as scheduleLogging() for a message which does not fit into one Logging buffer. Pieces are copied
+ * back to back: output buffer stays locked from first piece till last one. If some piece does not fit
+ * whole message is dropped.
+ */
+void scheduleLoggingPiece(Logging *logging, bool isFirstPiece, bool isLastPiece);
 
 // Stores the result of one call to efiPrintfInternal in the queue to be copied out to the output buffer
 struct LogLineBuffer {
@@ -45,6 +59,12 @@ class LogBuffer {
 public:
 	void writeLine(LogLineBuffer* line);
 	void writeLogger(Logging* logging);
+	/**
+	 * Unlike writeLogger() nothing is written if logger content does not fit whole
+	 * @return false if it did not fit
+	 */
+	bool tryWriteLogger(Logging* logging);
+	void truncate(size_t length);
 
 	size_t length() const;
 	void reset();
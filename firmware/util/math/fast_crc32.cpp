@@ -0,0 +1,119 @@
+/**
+ * @file	fast_crc32.cpp
+ *
+ * Slicing-by-8: tables[k][b] is CRC of byte b followed by k zero bytes, so eight bytes of input
+ * turn into eight independent table lookups. Tables are computed at compile time and live in flash.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "fast_crc32.h"
+
+// reflected 0x04C11DB7
+static constexpr uint32_t crc32Polynomial = 0xEDB88320;
+
+struct Crc32Tables {
+	uint32_t values[8][256];
+};
+
+static constexpr Crc32Tables makeCrc32Tables() {
+	Crc32Tables tables = {};
+
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc & 1) ? (crc >> 1) ^ crc32Polynomial : crc >> 1;
+		}
+		tables.values[0][i] = crc;
+	}
+
+	for (size_t k = 1; k < 8; k++) {
+		for (size_t i = 0; i < 256; i++) {
+			uint32_t previous = tables.values[k - 1][i];
+			tables.values[k][i] = (previous >> 8) ^ tables.values[0][previous & 0xFF];
+		}
+	}
+
+	return tables;
+}
+
+static constexpr Crc32Tables crc32Tables = makeCrc32Tables();
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "slicing-by-8 loads input as little endian words");
+
+uint32_t crc32SlicingBy8Inc(const void *buf, uint32_t crc, size_t size) {
+	const uint8_t *data = static_cast<const uint8_t *>(buf);
+	const auto& t = crc32Tables.values;
+
+	crc = ~crc;
+
+	while (size >= 8) {
+		uint32_t low;
+		uint32_t high;
+		// compiles into plain loads, no alignment requirement
+		memcpy(&low, data, sizeof(low));
+		memcpy(&high, data + 4, sizeof(high));
+		low ^= crc;
+
+		crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+			^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+
+		data += 8;
+		size -= 8;
+	}
+
+	while (size > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+		data++;
+		size--;
+	}
+
+	return ~crc;
+}
+
+uint32_t fastCrc32Inc(const void *buf, uint32_t crc, size_t size) {
+#if EFI_HW_CRC32
+	return hwCrc32Inc(buf, crc, size);
+#else
+	return crc32SlicingBy8Inc(buf, crc, size);
+#endif // EFI_HW_CRC32
+}
+
+/**
+ * a(x) * b(x) modulo polynomial, both in reflected bit order where x^0 is the top bit
+ */
+static uint32_t multiplyModPolynomial(uint32_t a, uint32_t b) {
+	uint32_t product = 0;
+
+	for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1) {
+		if (a & mask) {
+			product ^= b;
+		}
+		b = (b & 1) ? (b >> 1) ^ crc32Polynomial : b >> 1;
+	}
+
+	return product;
+}
+
+uint32_t crc32ZerosOperator(size_t length) {
+	// x^0
+	uint32_t result = 1u << 31;
+	// x^8 is one zero byte, squared for each bit of length
+	uint32_t power = 1u << 23;
+
+	while (length != 0) {
+		if (length & 1) {
+			result = multiplyModPolynomial(power, result);
+		}
+		power = multiplyModPolynomial(power, power);
+		length >>= 1;
+	}
+
+	return result;
+}
+
+uint32_t crc32Combine(uint32_t crcA, uint32_t crcB, uint32_t zerosOperator) {
+	return multiplyModPolynomial(zerosOperator, crcA) ^ crcB;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file	fast_crc32.h
+ *
+ * Same CRC32 as crc32()/crc32inc() from rusefi/crc.h (zlib flavour: reflected 0x04C11DB7, ~0 init and final xor)
+ * but computed either by MCU CRC peripheral where one is able to do it, or with slicing-by-8 lookup tables
+ * which handle eight bytes per step instead of one.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// MCU CRC unit with programmable initial value and bit reversal, see stm32_crc.cpp
+#ifndef EFI_HW_CRC32
+#define EFI_HW_CRC32 FALSE
+#endif
+
+uint32_t crc32SlicingBy8Inc(const void *buf, uint32_t crc, size_t size);
+
+#if EFI_HW_CRC32
+// implemented by MCU port
+uint32_t hwCrc32Inc(const void *buf, uint32_t crc, size_t size);
+#endif // EFI_HW_CRC32
+
+/**
+ * Best implementation available on this platform, drop-in replacement of crc32inc()
+ */
+uint32_t fastCrc32Inc(const void *buf, uint32_t crc, size_t size);
+
+inline uint32_t fastCrc32(const void *buf, size_t size) {
+	return fastCrc32Inc(buf, 0, size);
+}
+
+/**
+ * @return operator which turns CRC of A into CRC of A followed by 'length' zero bytes, see crc32Combine()
+ */
+uint32_t crc32ZerosOperator(size_t length);
+/**
+ * CRC of A followed by B from CRC of A and CRC of B without looking at the data
+ * @param zerosOperator crc32ZerosOperator() of B length
+ */
+uint32_t crc32Combine(uint32_t crcA, uint32_t crcB, uint32_t zerosOperator);
@@ -51,11 +51,13 @@ public class EnumNames {
 	"GlobalLock",
 	"GlobalUnlock",
 	"SoftwareKnockProcess",
+	"KnockAnalyzer",
 	"LogTriggerTooth",
 	"LuaTickFunction",
 	"LuaOneCanRxFunction",
 	"LuaAllCanRxFunction",
 	"LuaOneCanRxCallback",
 	"LuaOneCanTxFunction",
+	"PerfTraceTriggered",
 	};
 }
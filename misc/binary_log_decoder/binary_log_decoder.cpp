@@ -0,0 +1,315 @@
+/**
+ * Turns binary log records (see firmware/util/binary_log_format.h) back into text
+ *
+ * binary_log_decoder rusefi.elf console.log > decoded.log
+ *
+ * Everything except binary records is copied as is.
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_log_format.h"
+
+// see LOG_DELIMITER in rusefi_config.txt
+static constexpr char logDelimiter = '`';
+
+struct Section {
+	uint32_t address;
+	uint32_t size;
+	uint32_t offset;
+};
+
+class ElfImage {
+public:
+	bool load(const char* fileName) {
+		std::ifstream file(fileName, std::ios::binary);
+		m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		// 32 bit little endian only, that's what all our MCUs are
+		if (m_data.size() < 52 || memcmp(m_data.data(), "\x7f" "ELF", 4) != 0 || m_data[4] != 1 || m_data[5] != 1) {
+			return false;
+		}
+
+		uint32_t sectionHeaderOffset = read32(32);
+		uint16_t sectionHeaderSize = read16(46);
+		uint16_t sectionCount = read16(48);
+
+		for (size_t i = 0; i < sectionCount; i++) {
+			size_t header = sectionHeaderOffset + i * sectionHeaderSize;
+			if (header + 40 > m_data.size()) {
+				return false;
+			}
+
+			uint32_t type = read32(header + 4);
+			uint32_t flags = read32(header + 8);
+
+			// SHF_ALLOC sections with content, SHT_NOBITS is .bss
+			const uint32_t SHT_NOBITS = 8;
+			const uint32_t SHF_ALLOC = 2;
+			if (type == SHT_NOBITS || !(flags & SHF_ALLOC)) {
+				continue;
+			}
+
+			m_sections.push_back({ read32(header + 12), read32(header + 20), read32(header + 16) });
+		}
+
+		return true;
+	}
+
+	// @return nullptr if address is not within the image
+	const char* stringAt(uint32_t address) const {
+		for (const auto& section : m_sections) {
+			if (address >= section.address && address - section.address < section.size) {
+				size_t offset = section.offset + (address - section.address);
+				const char* start = m_data.data() + offset;
+				size_t maxLength = section.size - (address - section.address);
+				if (offset >= m_data.size() || memchr(start, 0, maxLength) == nullptr) {
+					return nullptr;
+				}
+				return start;
+			}
+		}
+
+		return nullptr;
+	}
+
+private:
+	uint32_t read32(size_t offset) const {
+		uint32_t value;
+		memcpy(&value, m_data.data() + offset, sizeof(value));
+		return value;
+	}
+
+	uint16_t read16(size_t offset) const {
+		uint16_t value;
+		memcpy(&value, m_data.data() + offset, sizeof(value));
+		return value;
+	}
+
+	std::vector<char> m_data;
+	std::vector<Section> m_sections;
+};
+
+class RecordReader {
+public:
+	RecordReader(const std::vector<uint8_t>& bytes) : m_bytes(bytes) { }
+
+	bool readU32(uint32_t& value) {
+		if (m_position + 4 > m_bytes.size()) {
+			return false;
+		}
+		value = 0;
+		for (size_t i = 0; i < 4; i++) {
+			value |= m_bytes[m_position++] << (8 * i);
+		}
+		return true;
+	}
+
+	bool readString(std::string& value) {
+		value.clear();
+		while (m_position < m_bytes.size()) {
+			char c = m_bytes[m_position++];
+			if (c == 0) {
+				return true;
+			}
+			value += c;
+		}
+		return false;
+	}
+
+private:
+	const std::vector<uint8_t>& m_bytes;
+	size_t m_position = 0;
+};
+
+// host printf knows nothing about ChibiOS long variants and we've already widened everything to 32 bit
+static std::string toHostSpec(const LogConversion& conversion, const std::vector<int>& stars) {
+	std::string spec;
+	size_t starIndex = 0;
+	for (const char* p = conversion.start; p < conversion.end - 1; p++) {
+		char c = *p;
+		if (c == 'l' || c == 'h' || c == 'L' || c == 'z' || c == 'j' || c == 't') {
+			continue;
+		}
+		if (c == '*') {
+			spec += std::to_string(stars[starIndex++]);
+			continue;
+		}
+		spec += c;
+	}
+
+	char type = conversion.end[-1];
+	switch (type) {
+	case 'D':
+		type = 'd';
+		break;
+	case 'U':
+		type = 'u';
+		break;
+	case 'O':
+		type = 'o';
+		break;
+	case 'p':
+		spec = "0x%08";
+		type = 'x';
+		break;
+	}
+	spec += type;
+	return spec;
+}
+
+static std::string decodeRecord(const ElfImage& elf, const std::vector<uint8_t>& bytes) {
+	RecordReader reader(bytes);
+
+	uint32_t formatAddress;
+	if (!reader.readU32(formatAddress)) {
+		return "[empty binary record]";
+	}
+
+	const char* format = elf.stringAt(formatAddress);
+	if (!format) {
+		std::ostringstream error;
+		error << "[unknown format string 0x" << std::hex << formatAddress << ", wrong ELF?]";
+		return error.str();
+	}
+
+	std::string result;
+	const char* literalStart = format;
+	const char* cursor = format;
+	LogConversion conversion;
+	char buffer[512];
+
+	while (nextLogConversion(cursor, conversion)) {
+		// literal text before this conversion, with "%%" unescaped
+		for (const char* p = literalStart; p < conversion.start; p++) {
+			result += *p;
+			if (p[0] == '%' && p[1] == '%') {
+				p++;
+			}
+		}
+		literalStart = conversion.end;
+
+		std::vector<int> stars;
+		bool isComplete = true;
+		for (size_t i = 0; i < conversion.starCount; i++) {
+			uint32_t star;
+			isComplete = isComplete && reader.readU32(star);
+			stars.push_back(star);
+		}
+
+		std::string spec = toHostSpec(conversion, stars);
+		uint32_t value = 0;
+		std::string text;
+
+		switch (conversion.type) {
+		case LogArgType::Float:
+			if ((isComplete = isComplete && reader.readU32(value))) {
+				float floatValue;
+				memcpy(&floatValue, &value, sizeof(floatValue));
+				snprintf(buffer, sizeof(buffer), spec.c_str(), (double)floatValue);
+			}
+			break;
+		case LogArgType::String:
+			if ((isComplete = isComplete && reader.readString(text))) {
+				snprintf(buffer, sizeof(buffer), spec.c_str(), text.c_str());
+			}
+			break;
+		case LogArgType::Int:
+			if ((isComplete = isComplete && reader.readU32(value))) {
+				snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+			}
+			break;
+		}
+
+		if (!isComplete) {
+			// ECU ran out of line buffer
+			return result + "[truncated]";
+		}
+
+		result += buffer;
+	}
+
+	for (const char* p = literalStart; *p; p++) {
+		result += *p;
+		if (p[0] == '%' && p[1] == '%') {
+			p++;
+		}
+	}
+
+	return result;
+}
+
+static bool parseHex(const std::string& hex, std::vector<uint8_t>& bytes) {
+	if (hex.size() % 2 != 0) {
+		return false;
+	}
+
+	for (char c : hex) {
+		if (!isxdigit(static_cast<unsigned char>(c))) {
+			return false;
+		}
+	}
+
+	bytes.clear();
+	for (size_t i = 0; i < hex.size(); i += 2) {
+		bytes.push_back(std::stoi(hex.substr(i, 2), nullptr, 16));
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		std::cerr << "Usage: binary_log_decoder firmware.elf log.txt" << std::endl;
+		return -1;
+	}
+
+	ElfImage elf;
+	if (!elf.load(argv[1])) {
+		std::cerr << "Not a 32 bit little endian ELF: " << argv[1] << std::endl;
+		return -1;
+	}
+
+	std::ifstream log(argv[2]);
+	if (!log) {
+		std::cerr << "Unable to open " << argv[2] << std::endl;
+		return -1;
+	}
+
+	const std::string tag = std::string(PROTOCOL_BINARY_MSG) + logDelimiter;
+	int decodedCount = 0;
+
+	std::string line;
+	while (std::getline(log, line)) {
+		size_t position = 0;
+		std::string output;
+
+		while (true) {
+			size_t tagStart = line.find(tag, position);
+			size_t hexStart = tagStart + tag.size();
+			size_t hexEnd = tagStart == std::string::npos ? std::string::npos : line.find(logDelimiter, hexStart);
+			std::vector<uint8_t> bytes;
+
+			if (hexEnd == std::string::npos || !parseHex(line.substr(hexStart, hexEnd - hexStart), bytes)) {
+				output += line.substr(position);
+				break;
+			}
+
+			output += line.substr(position, tagStart - position);
+			output += decodeRecord(elf, bytes);
+			decodedCount++;
+			position = hexEnd + 1;
+		}
+
+		std::cout << output << std::endl;
+	}
+
+	std::cerr << "Decoded " << decodedCount << " binary records" << std::endl;
+	return 0;
+}
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -std=c++17 -I../../firmware/util binary_log_decoder.cpp -o binary_log_decoder
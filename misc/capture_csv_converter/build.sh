@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -std=c++17 -I../../unit_tests/test-framework csv_to_binary.cpp -o csv_to_binary
@@ -0,0 +1,154 @@
+/**
+ * Converts digital CSV capture into pre-parsed binary form read by unit tests CsvReader
+ * See unit_tests/test-framework/trigger_capture_format.h
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "trigger_capture_format.h"
+
+static std::string trim(const std::string& str) {
+	size_t start = str.find_first_not_of(" \t\r\n");
+	if (start == std::string::npos) {
+		return "";
+	}
+	size_t end = str.find_last_not_of(" \t\r\n");
+	return str.substr(start, end - start + 1);
+}
+
+static std::vector<std::string> split(const std::string& line) {
+	std::vector<std::string> result;
+	size_t start = 0;
+	while (true) {
+		size_t comma = line.find(',', start);
+		result.push_back(trim(line.substr(start, comma == std::string::npos ? std::string::npos : comma - start)));
+		if (comma == std::string::npos) {
+			return result;
+		}
+		start = comma + 1;
+	}
+}
+
+/**
+ * Timestamp is stored as whole nanoseconds plus number of steps to the exact double CsvReader gets from std::stod()
+ */
+static bool toNs(double seconds, int64_t& ns, int8_t& ulpCorrection) {
+	ns = std::llround(seconds * 1e9);
+	double approximation = ns / 1e9;
+	int direction = approximation < seconds ? 1 : -1;
+	for (int correction = 0; correction < INT8_MAX; correction++) {
+		if (approximation == seconds) {
+			ulpCorrection = direction * correction;
+			return true;
+		}
+		approximation = std::nextafter(approximation, seconds);
+	}
+	// timestamp has resolution finer than a nanosecond
+	return false;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		std::cerr << "Usage: csv_to_binary capture.csv capture.bin" << std::endl;
+		return -1;
+	}
+
+	std::ifstream src(argv[1]);
+	if (!src) {
+		std::cerr << "Unable to read " << argv[1] << std::endl;
+		return -1;
+	}
+
+	capture_binary_header_s header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CAPTURE_BINARY_MAGIC, sizeof(header.magic));
+	header.version = CAPTURE_BINARY_VERSION;
+
+	std::vector<capture_binary_record_s> records;
+	std::string line;
+	int lineIndex = -1;
+	int64_t previousNs = 0;
+	int columnCount = -1;
+
+	while (std::getline(src, line)) {
+		lineIndex++;
+		if (lineIndex == 0) {
+			// header
+			continue;
+		}
+		if (trim(line).empty()) {
+			// CsvReader skips blank lines the same way
+			continue;
+		}
+
+		std::vector<std::string> tokens = split(line);
+		int64_t nowNs;
+		int8_t ulpCorrection;
+		if (!toNs(std::stod(tokens[0]), nowNs, ulpCorrection)) {
+			std::cerr << argv[1] << ": unsupported timestamp [" << tokens[0] << "] at line " << lineIndex << std::endl;
+			return -1;
+		}
+
+		int lineColumns = tokens.size() - 1;
+		if (columnCount == -1) {
+			columnCount = lineColumns;
+			if (columnCount > CAPTURE_BINARY_MAX_COLUMNS) {
+				std::cerr << argv[1] << ": too many columns " << columnCount << std::endl;
+				return -1;
+			}
+			header.columnCount = columnCount;
+			header.startNs = nowNs;
+			previousNs = nowNs;
+		} else if (lineColumns != columnCount) {
+			std::cerr << argv[1] << ": unexpected column count at line " << lineIndex << std::endl;
+			return -1;
+		}
+
+		uint8_t columns = 0;
+		for (int i = 0; i < columnCount; i++) {
+			const std::string& value = tokens[i + 1];
+			if (value == "1") {
+				columns |= 1 << i;
+			} else if (value != "0") {
+				std::cerr << argv[1] << ": not a digital capture, [" << value << "] at line " << lineIndex << std::endl;
+				return -1;
+			}
+		}
+
+		int64_t deltaNs = nowNs - previousNs;
+		if (deltaNs < 0) {
+			std::cerr << argv[1] << ": time goes backwards at line " << lineIndex << std::endl;
+			return -1;
+		}
+		while (deltaNs > std::numeric_limits<uint32_t>::max()) {
+			records.push_back({ std::numeric_limits<uint32_t>::max(), CAPTURE_RECORD_TIME_ONLY, 0 });
+			deltaNs -= std::numeric_limits<uint32_t>::max();
+		}
+		records.push_back({ (uint32_t)deltaNs, ulpCorrection, columns });
+		previousNs = nowNs;
+	}
+
+	header.recordCount = records.size();
+
+	std::ifstream raw(argv[1], std::ios::binary | std::ios::ate);
+	header.sourceSize = raw.tellg();
+
+	FILE *dst = fopen(argv[2], "wb");
+	if (dst == nullptr) {
+		std::cerr << "Unable to write " << argv[2] << std::endl;
+		return -1;
+	}
+	fwrite(&header, sizeof(header), 1, dst);
+	fwrite(records.data(), sizeof(capture_binary_record_s), records.size(), dst);
+	fclose(dst);
+
+	std::cout << argv[1] << ": " << records.size() << " records, " << columnCount << " columns" << std::endl;
+	return 0;
+}
@@ -728,7 +728,8 @@
  * @details This hook is continuously invoked by the idle thread loop.
  */
 #define CH_CFG_IDLE_LOOP_HOOK() {                                           \
-  /* Idle loop code here.*/                                                 \
+  /* Advances clock in virtual time mode, see virtual_time.cpp */           \
+  onSimulatorIdle();                                                        \
 }
 
 /**
@@ -744,6 +745,10 @@
 #include <stdlib.h>
 #include <stdarg.h>
 
+#if !defined(_FROM_ASM_)
+#include "virtual_time.h"
+#endif
+
 /**
  * @brief   System halt hook.
  * @details This hook is invoked in case to a system halting error before
@@ -18,6 +18,7 @@
 #include "chprintf.h"
 #include "rusEfiFunctionalTest.h"
 #include "flash_int.h"
+#include "virtual_time.h"
 
 #include <iostream>
 #include <filesystem>
@@ -143,6 +144,18 @@ static virtual_timer_t exitTimer;
 int main(int argc, char** argv) {
 	setbuf(stdout, NULL);
 
+	int timeoutSeconds = 0;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--virtual-time") == 0) {
+			if (!enableVirtualTime()) {
+				printf("Virtual time is not supported by this build\n");
+				return -1;
+			}
+		} else {
+			timeoutSeconds = atoi(argv[i]);
+		}
+	}
+
 	/*
 	 * System initializations.
 	 * - HAL initialization, this also initializes the configured device drivers
@@ -153,12 +166,15 @@ int main(int argc, char** argv) {
 	halInit();
 	chSysInit();
 
-	if (argc == 2) {
-		int timeoutSeconds = atoi(argv[1]);
-		printf("Running rusEFI simulator for %d seconds, then exiting.\n\n", timeoutSeconds);
+	if (timeoutSeconds > 0) {
+		printf("Running rusEFI simulator for %d %s seconds, then exiting.\n\n", timeoutSeconds,
+			isVirtualTimeEnabled() ? "virtual" : "real");
 
 		chSysLock();
-		chVTSetI(&exitTimer, MY_US2ST(timeoutSeconds * 1e6), [](void*) { exit(0); }, nullptr);
+		chVTSetI(&exitTimer, MY_US2ST(timeoutSeconds * 1e6), [](void*) {
+			printVirtualTimeSummary();
+			exit(0);
+		}, nullptr);
 		chSysUnlock();
 	}
 
@@ -59,6 +59,7 @@
 #define EFI_ANTILAG_SYSTEM TRUE
 
 #define ENABLE_PERF_TRACE FALSE
+#define EFI_THREAD_PROFILER FALSE
 
 #define EFI_PRINTF_FUEL_DETAILS FALSE
 
@@ -96,6 +97,8 @@
 #define BOARD_TLE8888_COUNT 	0
 
 #define EFI_TEXT_LOGGING TRUE
+// binary log records carry 32 bit format string addresses
+#define EFI_BINARY_LOGGING FALSE
 
 #define EFI_MEMS FALSE
 
@@ -172,6 +175,7 @@
 #define SPARK_EXTREME_LOGGING FALSE
 #define DEBUG_PWM FALSE
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER FALSE
+#define EFI_LOW_PRIORITY_SCHEDULER FALSE
 #define EFI_TUNER_STUDIO_VERBOSE FALSE
 #define EFI_FILE_LOGGING TRUE
 #define EFI_WARNING_LED FALSE
@@ -0,0 +1,112 @@
+/**
+ * @file	virtual_time.cpp
+ * @brief   Faster than real time simulator clock
+ *
+ * ChibiOS POSIX port derives system tick from gettimeofday(). In virtual time mode the port gets
+ * a clock which stands still while any thread is busy and jumps straight to the next armed virtual
+ * timer once all threads are idle. Trigger emulator, fuel/spark events and periodic controllers
+ * are all virtual timers or thread sleeps underneath, so simulation is deterministic and runs as
+ * fast as host CPU allows.
+ *
+ * Linker has to route gettimeofday() through __wrap_gettimeofday, see Makefile.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+#include "virtual_time.h"
+
+#include <sys/time.h>
+#include <time.h>
+
+#define US_PER_TICK (1000000 / CH_CFG_ST_FREQUENCY)
+
+static bool isVirtualTime = false;
+
+// Microseconds since epoch, as reported to ChibiOS
+static uint64_t virtualNowUs;
+static uint64_t virtualStartUs;
+
+// 64 bit system tick counter, systime_t overflows after a few hours of simulation
+static uint64_t ticksSinceStart;
+static systime_t lastSystemTime;
+
+#if EFI_SIM_VIRTUAL_TIME
+
+static struct timespec wallStart;
+
+extern "C" int __real_gettimeofday(struct timeval *tv, void *tz);
+
+extern "C" int __wrap_gettimeofday(struct timeval *tv, void *tz) {
+	if (!isVirtualTime) {
+		return __real_gettimeofday(tv, tz);
+	}
+
+	tv->tv_sec = virtualNowUs / 1000000;
+	tv->tv_usec = virtualNowUs % 1000000;
+	return 0;
+}
+
+bool enableVirtualTime() {
+	struct timeval now;
+	__real_gettimeofday(&now, nullptr);
+	virtualStartUs = virtualNowUs = (uint64_t)now.tv_sec * 1000000 + now.tv_usec;
+	clock_gettime(CLOCK_MONOTONIC, &wallStart);
+
+	isVirtualTime = true;
+	return true;
+}
+
+void printVirtualTimeSummary() {
+	if (!isVirtualTime) {
+		return;
+	}
+
+	struct timespec wallNow;
+	clock_gettime(CLOCK_MONOTONIC, &wallNow);
+	double wallSeconds = (wallNow.tv_sec - wallStart.tv_sec) + (wallNow.tv_nsec - wallStart.tv_nsec) * 1e-9;
+	double simulatedSeconds = (virtualNowUs - virtualStartUs) * 1e-6;
+
+	printf("Simulated %.1f seconds in %.1f seconds of wall time, %.1fx real time\n",
+		simulatedSeconds, wallSeconds, wallSeconds > 0 ? simulatedSeconds / wallSeconds : 0);
+}
+
+#else
+
+bool enableVirtualTime() {
+	return false;
+}
+
+void printVirtualTimeSummary() {
+}
+
+#endif // EFI_SIM_VIRTUAL_TIME
+
+bool isVirtualTimeEnabled() {
+	return isVirtualTime;
+}
+
+void onSimulatorIdle() {
+	if (!isVirtualTime) {
+		return;
+	}
+
+	sysinterval_t untilNextTimer;
+	chSysLock();
+	bool hasTimers = chVTGetTimersStateI(&untilNextTimer);
+	systime_t now = chVTGetSystemTimeX();
+	chSysUnlock();
+
+	ticksSinceStart += (systime_t)(now - lastSystemTime);
+	lastSystemTime = now;
+
+	if (!hasTimers || untilNextTimer == 0) {
+		untilNextTimer = 1;
+	}
+
+	// Port fires one tick per check so it catches up over next few idle loops, target stays the same meanwhile
+	uint64_t target = virtualStartUs + (ticksSinceStart + untilNextTimer) * US_PER_TICK;
+	if (target > virtualNowUs) {
+		virtualNowUs = target;
+	}
+}
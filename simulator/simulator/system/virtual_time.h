@@ -0,0 +1,27 @@
+/**
+ * @file	virtual_time.h
+ * @brief   Faster than real time simulator clock
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+/**
+ * Switch simulator to virtual time, has to be invoked before halInit()
+ * @return false if this build does not support virtual time
+ */
+bool enableVirtualTime();
+bool isVirtualTimeEnabled();
+/**
+ * Print how much engine time was simulated and how long it took
+ */
+void printVirtualTimeSummary();
+
+extern "C"
+#endif
+/**
+ * Invoked by ChibiOS idle thread, see CH_CFG_IDLE_LOOP_HOOK
+ */
+void onSimulatorIdle(void);
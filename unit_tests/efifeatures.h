@@ -33,6 +33,7 @@
 #define EFI_PRINTF_FUEL_DETAILS TRUE
 
 #define ENABLE_PERF_TRACE FALSE
+#define EFI_THREAD_PROFILER FALSE
 
 #define EFI_TOOTH_LOGGER TRUE
 
@@ -59,12 +60,14 @@
 #define DEBUG_INTERPOLATION TRUE
 
 #define EFI_TEXT_LOGGING TRUE
+#define EFI_BINARY_LOGGING FALSE
 
 #define EFI_HISTOGRAMS FALSE
 
 #define EFI_CLI_SUPPORT FALSE
 
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER FALSE
+#define EFI_LOW_PRIORITY_SCHEDULER FALSE
 #define EFI_SIGNAL_EXECUTOR_SLEEP FALSE
 
 #define EFI_SHAFT_POSITION_INPUT TRUE
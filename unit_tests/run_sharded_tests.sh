@@ -2,15 +2,37 @@
 
 # This script runs every test in its own process (own invocation of rusefi_test executable)
 # This allows us to test for accidental cross-test leakage that fixes/breaks something
+#
+# Shards are independent processes so we run as many of them at once as we have cores.
+# Output of each shard goes into its own log, only failed shards are printed.
+# SHARDS and JOBS environment variables override defaults.
 
-set -e
+SHARDS=${SHARDS:-600}
+JOBS=${JOBS:-$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)}
 
-export GTEST_TOTAL_SHARDS=600
-for IDX in {0..599}
-do
-	export GTEST_SHARD_INDEX=$IDX
-	build/rusefi_test
-done
+LOG_DIR=$(mktemp -d)
+trap 'rm -rf "$LOG_DIR"' EXIT
 
-unset GTEST_TOTAL_SHARDS
-unset GTEST_SHARD_INDEX
+run_shard() {
+	local IDX=$1
+	if ! GTEST_TOTAL_SHARDS=$SHARDS GTEST_SHARD_INDEX=$IDX build/rusefi_test > "$LOG_DIR/shard_$IDX.log" 2>&1; then
+		touch "$LOG_DIR/shard_$IDX.failed"
+	fi
+}
+export -f run_shard
+export SHARDS LOG_DIR
+
+echo "Running $SHARDS shards, $JOBS at a time"
+seq 0 $((SHARDS - 1)) | xargs -P "$JOBS" -I{} bash -c 'run_shard {}'
+
+FAILED=$(ls "$LOG_DIR" | grep '\.failed$' | sed 's/\.failed$//' | sort -t_ -k2 -n)
+if [ -n "$FAILED" ]; then
+	for SHARD in $FAILED; do
+		echo "========== $SHARD failed =========="
+		cat "$LOG_DIR/$SHARD.log"
+	done
+	echo "Failed shards:" $FAILED
+	exit 1
+fi
+
+echo "All $SHARDS shards passed"
@@ -0,0 +1,11 @@
+#!/bin/bash
+
+# Trigger decoding throughput over recorded captures, see tests/trigger/test_trigger_benchmark.cpp
+# Results are written to test_results/trigger_benchmark.txt
+# Replay has to be allocation-free: sanitizer build (SANITIZE=yes, default on Linux and Mac) counts
+# every malloc(), SANITIZE=no build only counts operator new
+
+set -e
+
+mkdir -p test_results
+build/rusefi_test --gtest_also_run_disabled_tests --gtest_filter='*TriggerBenchmark*'
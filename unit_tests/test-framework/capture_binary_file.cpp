@@ -0,0 +1,144 @@
+/*
+ * @file capture_binary_file.cpp
+ */
+
+#include "pch.h"
+#include "capture_binary_file.h"
+
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+CaptureBinaryFile::~CaptureBinaryFile() {
+	close();
+}
+
+bool CaptureBinaryFile::map(const char *fileName) {
+#ifdef _WIN32
+	FILE *fp = fopen(fileName, "rb");
+	if (fp == nullptr) {
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	m_buffer.resize(size > 0 ? size : 0);
+	bool isRead = size > 0 && fread(m_buffer.data(), 1, size, fp) == (size_t)size;
+	fclose(fp);
+	if (!isRead) {
+		m_buffer.clear();
+		return false;
+	}
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+#else
+	int fd = ::open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// mapping stays valid after file descriptor is closed
+	::close(fd);
+	if (mapped == MAP_FAILED) {
+		return false;
+	}
+	m_data = (const uint8_t *)mapped;
+	m_size = st.st_size;
+#endif
+	return true;
+}
+
+bool CaptureBinaryFile::open(const char *csvFileName) {
+	close();
+
+	std::string fileName = getBinaryFileName(csvFileName);
+	if (!map(fileName.c_str())) {
+		return false;
+	}
+
+	// same freshness rule as make uses to re-generate the binary: not older than CSV
+	// plus CSV size as a cheap sanity check, no need to read the whole CSV on every open
+	struct stat csvStat;
+	struct stat binaryStat;
+	bool isFresh = stat(csvFileName, &csvStat) == 0
+			&& stat(fileName.c_str(), &binaryStat) == 0
+			&& binaryStat.st_mtime >= csvStat.st_mtime;
+
+	auto header = (const capture_binary_header_s *)m_data;
+	if (m_size < sizeof(*header)
+			|| memcmp(header->magic, CAPTURE_BINARY_MAGIC, sizeof(header->magic)) != 0
+			|| header->version != CAPTURE_BINARY_VERSION
+			|| m_size != sizeof(*header) + header->recordCount * sizeof(capture_binary_record_s)) {
+		printf("Ignoring invalid binary capture %s\r\n", fileName.c_str());
+		close();
+		return false;
+	}
+
+	if (!isFresh || (uint32_t)csvStat.st_size != header->sourceSize) {
+		printf("Ignoring outdated binary capture %s, make re-generates it\r\n", fileName.c_str());
+		close();
+		return false;
+	}
+
+	m_header = header;
+	m_records = (const capture_binary_record_s *)(m_data + sizeof(*header));
+	m_index = 0;
+	m_nowNs = header->startNs;
+	m_timestamp = 0;
+	m_columns = 0;
+	return true;
+}
+
+void CaptureBinaryFile::close() {
+#ifdef _WIN32
+	m_buffer.clear();
+#else
+	if (m_data != nullptr) {
+		munmap((void *)m_data, m_size);
+	}
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_header = nullptr;
+	m_records = nullptr;
+}
+
+bool CaptureBinaryFile::next() {
+	while (m_index < m_header->recordCount) {
+		const capture_binary_record_s& record = m_records[m_index++];
+		m_nowNs += record.deltaNs;
+		if (record.ulpCorrection == CAPTURE_RECORD_TIME_ONLY) {
+			// long gap continues in next record
+			continue;
+		}
+
+		m_timestamp = m_nowNs / 1e9;
+		for (int i = 0; i < record.ulpCorrection; i++) {
+			m_timestamp = std::nextafter(m_timestamp, INFINITY);
+		}
+		for (int i = 0; i > record.ulpCorrection; i--) {
+			m_timestamp = std::nextafter(m_timestamp, -INFINITY);
+		}
+		m_columns = record.columns;
+		return true;
+	}
+	return false;
+}
+
+std::string CaptureBinaryFile::getBinaryFileName(const char *csvFileName) {
+	std::string name = csvFileName;
+	const std::string csv = ".csv";
+	if (name.size() >= csv.size() && name.compare(name.size() - csv.size(), csv.size(), csv) == 0) {
+		name.resize(name.size() - csv.size());
+	}
+	return CAPTURE_BINARY_DIR + name + CAPTURE_BINARY_EXTENSION;
+}
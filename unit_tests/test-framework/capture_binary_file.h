@@ -0,0 +1,75 @@
+/*
+ * @file capture_binary_file.h
+ *
+ * Read-only view of pre-parsed capture, see trigger_capture_format.h
+ * File is memory mapped and records are iterated in place.
+ */
+
+#pragma once
+
+#include "trigger_capture_format.h"
+
+// Binary captures are generated by unit_tests Makefile, same relative path as CSV under this folder
+#ifndef CAPTURE_BINARY_DIR
+#define CAPTURE_BINARY_DIR "build/captures/"
+#endif
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class CaptureBinaryFile {
+public:
+	~CaptureBinaryFile();
+
+	/**
+	 * Opens binary capture converted from given CSV
+	 * @return false if there is no up to date binary capture for this CSV
+	 */
+	bool open(const char *csvFileName);
+	void close();
+
+	bool isOpen() const {
+		return m_header != nullptr;
+	}
+
+	/**
+	 * Advance to next CSV line
+	 * @return false at the end of capture
+	 */
+	bool next();
+
+	double timestampSeconds() const {
+		return m_timestamp;
+	}
+
+	int columnCount() const {
+		return m_header->columnCount;
+	}
+
+	bool column(int index) const {
+		return m_columns & (1 << index);
+	}
+
+	/**
+	 * Location of binary capture matching given CSV file
+	 */
+	static std::string getBinaryFileName(const char *csvFileName);
+
+private:
+	bool map(const char *fileName);
+
+	const uint8_t *m_data = nullptr;
+	size_t m_size = 0;
+#ifdef _WIN32
+	std::vector<uint8_t> m_buffer;
+#endif
+
+	const capture_binary_header_s *m_header = nullptr;
+	const capture_binary_record_s *m_records = nullptr;
+
+	uint32_t m_index = 0;
+	int64_t m_nowNs = 0;
+	double m_timestamp = 0;
+	uint8_t m_columns = 0;
+};
@@ -24,6 +24,7 @@ bool unitTestBusyWaitHack;
 
 #if EFI_ENGINE_SNIFFER
 #include "engine_sniffer.h"
+#include "ts_config_staging.h"
 extern WaveChart waveChart;
 #endif /* EFI_ENGINE_SNIFFER */
 
@@ -39,6 +40,7 @@ EngineTestHelperBase::EngineTestHelperBase(Engine * eng, engine_configuration_s
 	setTimeNowUs(0);
 	minCrankingRpm = 0;
 	ButtonDebounce::resetForUnitTests();
+	resetConfigStagingForUnitTests();
 	unitTestBusyWaitHack = false;
 	EnableToothLogger();
 	if (engine || engineConfiguration || config) {
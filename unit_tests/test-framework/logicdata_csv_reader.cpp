@@ -16,6 +16,10 @@ static char* trim(char *str) {
 	return str;
 }
 
+static bool isBlank(const char *line) {
+	return line[strspn(line, " \t\r\n")] == 0;
+}
+
 CsvReader::~CsvReader() {
 	if (fp) {
 		fclose(fp);
@@ -23,19 +27,36 @@ CsvReader::~CsvReader() {
 }
 
 void CsvReader::open(const char *fileName, const int* triggerColumnIndeces, const int *vvtColumnIndeces) {
-	printf("Reading from %s\r\n", fileName);
-	fp = fopen(fileName, "r");
 	this->triggerColumnIndeces = triggerColumnIndeces;
 	this->vvtColumnIndeces = vvtColumnIndeces;
+
+	if (binary.open(fileName)) {
+		printf("Reading from %s\r\n", CaptureBinaryFile::getBinaryFileName(fileName).c_str());
+		return;
+	}
+
+	printf("Reading from %s\r\n", fileName);
+	fp = fopen(fileName, "r");
 	ASSERT_TRUE(fp != nullptr);
 }
 
 bool CsvReader::haveMore() {
-	if (fp == nullptr) {
+	if (fp == nullptr && !binary.isOpen()) {
 		throw std::runtime_error("No file");
 	}
-	bool result = fgets(buffer, sizeof(buffer), fp) != nullptr;
 	m_lineIndex++;
+	if (binary.isOpen()) {
+		if (m_lineIndex == 0) {
+			// header line is not part of binary capture but still counts as line
+			m_lineIndex++;
+		}
+		return binary.next();
+	}
+	bool result = fgets(buffer, sizeof(buffer), fp) != nullptr;
+	// blank lines after header are not counted, same as in binary capture
+	while (result && m_lineIndex > 0 && isBlank(buffer)) {
+		result = fgets(buffer, sizeof(buffer), fp) != nullptr;
+	}
 	if (m_lineIndex == 0) {
 		// skip header
 		return haveMore();
@@ -54,6 +75,13 @@ static const char COMMA_SEPARATOR[2] = ",";
  * @return timestamp of current line
  */
 double CsvReader::readTimestampAndValues(double *values) {
+	if (binary.isOpen()) {
+		for (size_t i = 0; i < m_triggerCount; i++) {
+			values[i] = binary.column(i) ? 1 : 0;
+		}
+		return binary.timestampSeconds();
+	}
+
 	char *timeStampstr = readFirstTokenAndRememberInputString(buffer);
 	double timeStamp = std::stod(timeStampstr);
 
@@ -65,19 +93,12 @@ double CsvReader::readTimestampAndValues(double *values) {
 	return timeStamp;
 }
 
-// todo: separate trigger handling from csv file processing, maybe reuse 'readTimestampAndValues'?
-void CsvReader::processLine(EngineTestHelper *eth) {
-	Engine *engine = &eth->engine;
-
-	const char s[2] = ",";
+double CsvReader::readCsvLine(bool *newTriggerState, bool *newVvtState) {
 	char *timeStampstr = readFirstTokenAndRememberInputString(buffer);
 
-  for (int i = 0;i<readingOffset;i++) {
-    readNextToken();
-  }
-
-	bool newTriggerState[TRIGGER_INPUT_PIN_COUNT];
-	bool newVvtState[CAM_INPUTS_COUNT];
+	for (int i = 0;i<readingOffset;i++) {
+		readNextToken();
+	}
 
 	for (size_t i = 0;i<m_triggerCount;i++) {
 		char * triggerToken = readNextToken();
@@ -95,10 +116,48 @@ void CsvReader::processLine(EngineTestHelper *eth) {
 
 	if (timeStampstr == nullptr) {
 		criticalError("End of File");
+		return NAN;
+	}
+
+	return std::stod(timeStampstr);
+}
+
+double CsvReader::readBinaryLine(bool *newTriggerState, bool *newVvtState) {
+	// same column order as CSV tokens
+	int column = readingOffset;
+
+	for (size_t i = 0;i<m_triggerCount;i++) {
+		newTriggerState[triggerColumnIndeces[i]] = binary.column(column++);
+	}
+
+	for (size_t i = 0;i<m_vvtCount;i++) {
+		if (column >= binary.columnCount()) {
+			criticalError("No column %d at line %d", column, m_lineIndex);
+		}
+		newVvtState[vvtColumnIndeces[i]] = binary.column(column++);
+	}
+
+	return binary.timestampSeconds();
+}
+
+double CsvReader::readStates(bool *newTriggerState, bool *newVvtState) {
+	return binary.isOpen()
+		? readBinaryLine(newTriggerState, newVvtState)
+		: readCsvLine(newTriggerState, newVvtState);
+}
+
+// todo: separate trigger handling from csv file processing, maybe reuse 'readTimestampAndValues'?
+void CsvReader::processLine(EngineTestHelper *eth) {
+	Engine *engine = &eth->engine;
+
+	bool newTriggerState[TRIGGER_INPUT_PIN_COUNT];
+	bool newVvtState[CAM_INPUTS_COUNT];
+
+	double timeStamp = readStates(newTriggerState, newVvtState);
+	if (std::isnan(timeStamp)) {
 		return;
 	}
 
-	double timeStamp = std::stod(timeStampstr);
 	history.add(timeStamp);
 
 	timeStamp += m_timestampOffset;
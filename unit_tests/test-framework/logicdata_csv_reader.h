@@ -5,6 +5,10 @@
  * @author Andrey Belomutskiy, (c) 2012-2021
  */
 
+#pragma once
+
+#include "capture_binary_file.h"
+
 const int NORMAL_ORDER[2] = {0, 1};
 
 const int REVERSE_ORDER[2] = {1, 0};
@@ -28,6 +32,11 @@ public:
 	void processLine(EngineTestHelper *eth);
 	void readLine(EngineTestHelper *eth);
 	double readTimestampAndValues(double *v);
+	/**
+	 * Reads current line without feeding it anywhere
+	 * @return timestamp of current line, NAN at the end of file
+	 */
+	double readStates(bool *newTriggerState, bool *newVvtState);
 
 	bool flipOnRead = false;
 	bool flipVvtOnRead = false;
@@ -40,6 +49,9 @@ public:
   cyclic_buffer<double, 720> history;
 
 private:
+	double readCsvLine(bool *newTriggerState, bool *newVvtState);
+	double readBinaryLine(bool *newTriggerState, bool *newVvtState);
+
 	const size_t m_triggerCount;
 	const size_t m_vvtCount;
 	const double m_timestampOffset;
@@ -47,6 +59,9 @@ private:
 	FILE *fp = nullptr;
 	char buffer[255];
 
+	// pre-parsed copy of the same capture, used instead of 'fp' if present
+	CaptureBinaryFile binary;
+
 	bool currentState[TRIGGER_INPUT_PIN_COUNT] = {0, 0};
 	bool currentVvtState[CAM_INPUTS_COUNT] = {0, 0};
 
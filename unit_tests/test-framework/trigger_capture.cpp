@@ -0,0 +1,76 @@
+/*
+ * @file trigger_capture.cpp
+ */
+
+#include "pch.h"
+#include "trigger_capture.h"
+
+void TriggerCapture::load(const char *fileName, size_t triggerCount, size_t vvtCount,
+		const int* triggerColumnIndeces, const int *vvtColumnIndeces) {
+	m_edges.clear();
+
+	CsvReader reader(triggerCount, vvtCount);
+	reader.open(fileName, triggerColumnIndeces, vvtColumnIndeces);
+
+	bool currentState[TRIGGER_INPUT_PIN_COUNT] = {0, 0};
+	bool currentVvtState[CAM_INPUTS_COUNT] = {0, 0};
+
+	while (reader.haveMore()) {
+		bool newTriggerState[TRIGGER_INPUT_PIN_COUNT];
+		bool newVvtState[CAM_INPUTS_COUNT];
+
+		double timestamp = reader.readStates(newTriggerState, newVvtState);
+		if (std::isnan(timestamp)) {
+			break;
+		}
+		double timestampUs = 1'000'000 * timestamp;
+
+		// same order as CsvReader::processLine: all trigger channels then all cam channels
+		for (size_t i = 0; i < triggerCount; i++) {
+			if (currentState[i] != newTriggerState[i]) {
+				m_edges.push_back({ timestampUs, (uint8_t)i, /*isVvt*/ false, newTriggerState[i] });
+				currentState[i] = newTriggerState[i];
+			}
+		}
+
+		for (size_t i = 0; i < vvtCount; i++) {
+			if (currentVvtState[i] != newVvtState[i]) {
+				m_edges.push_back({ timestampUs, (uint8_t)i, /*isVvt*/ true, newVvtState[i] });
+				currentVvtState[i] = newVvtState[i];
+			}
+		}
+	}
+}
+
+size_t TriggerCapture::replay(EngineTestHelper *eth, double timeOffsetUs) const {
+	for (const auto& edge : m_edges) {
+		eth->setTimeAndInvokeEventsUs(edge.timestampUs + timeOffsetUs);
+		efitick_t nowNt = getTimeNowNt();
+
+		if (edge.isVvt) {
+			TriggerValue event = edge.state ^ engineConfiguration->invertCamVVTSignal ? TriggerValue::RISE : TriggerValue::FALL;
+			int bankIndex;
+			int camIndex;
+			if (twoBanksSingleCamMode) {
+				bankIndex = edge.index;
+				camIndex = 0;
+			} else {
+				bankIndex = edge.index / 2;
+				camIndex = edge.index % 2;
+			}
+			hwHandleVvtCamSignal(event, nowNt, bankIndex * 2 + camIndex);
+		} else {
+			bool invert = edge.index == 0 ? engineConfiguration->invertPrimaryTriggerSignal : engineConfiguration->invertSecondaryTriggerSignal;
+			hwHandleShaftSignal(edge.index, edge.state ^ invert, nowNt);
+		}
+	}
+
+	return m_edges.size();
+}
+
+double TriggerCapture::durationSeconds() const {
+	if (m_edges.empty()) {
+		return 0;
+	}
+	return (m_edges.back().timestampUs - m_edges.front().timestampUs) / 1e6;
+}
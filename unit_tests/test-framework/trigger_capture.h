@@ -0,0 +1,51 @@
+/*
+ * @file trigger_capture.h
+ *
+ * Recorded trigger capture loaded into memory upfront, so that replay is not slowed down by file reading.
+ */
+
+#pragma once
+
+#include "logicdata_csv_reader.h"
+
+#include <vector>
+
+struct TriggerCaptureEdge {
+	double timestampUs;
+	// trigger input index or VVT input index, see 'isVvt'
+	uint8_t index;
+	bool isVvt;
+	bool state;
+};
+
+class TriggerCapture {
+public:
+	/**
+	 * Reads whole capture with CsvReader, so binary copy of the CSV is used when there is one
+	 */
+	void load(const char *fileName, size_t triggerCount, size_t vvtCount,
+			const int* triggerColumnIndeces = NORMAL_ORDER, const int *vvtColumnIndeces = NORMAL_ORDER);
+
+	/**
+	 * Feeds all edges into trigger central, invoking scheduled events in between
+	 * @param timeOffsetUs added to all timestamps, allows replaying the same capture more than once
+	 * @return number of edges fed
+	 */
+	size_t replay(EngineTestHelper *eth, double timeOffsetUs = 0) const;
+
+	size_t size() const {
+		return m_edges.size();
+	}
+
+	double startUs() const {
+		return m_edges.empty() ? 0 : m_edges.front().timestampUs;
+	}
+
+	double durationSeconds() const;
+
+	/* when reading two cam channels it's either on intake one exhaust or two intakes on different banks */
+	bool twoBanksSingleCamMode = true;
+
+private:
+	std::vector<TriggerCaptureEdge> m_edges;
+};
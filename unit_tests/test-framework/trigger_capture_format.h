@@ -0,0 +1,48 @@
+/*
+ * @file trigger_capture_format.h
+ *
+ * Pre-parsed binary form of a digital CSV capture, see misc/capture_csv_converter
+ * One record per CSV line: time since previous line plus state of all columns.
+ * Timestamps are kept as integer nanoseconds plus a few ULP correction so that replay gets exactly
+ * the same double as parsing original CSV text.
+ *
+ * This header is shared with the converter tool so it has to stay free of rusEFI dependencies.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define CAPTURE_BINARY_MAGIC "REDG"
+#define CAPTURE_BINARY_VERSION 3
+#define CAPTURE_BINARY_EXTENSION ".bin"
+
+// 'ulpCorrection' value which marks a record which only carries time
+#define CAPTURE_RECORD_TIME_ONLY INT8_MIN
+#define CAPTURE_BINARY_MAX_COLUMNS 8
+
+struct __attribute__ ((packed)) capture_binary_header_s {
+	char magic[4];
+	uint8_t version;
+	uint8_t columnCount;
+	uint16_t reserved;
+	// timestamp of first line
+	int64_t startNs;
+	uint32_t recordCount;
+	// size of CSV this was converted from, binary is ignored once CSV is changed, see CaptureBinaryFile::open()
+	uint32_t sourceSize;
+};
+
+static_assert(sizeof(capture_binary_header_s) == 24);
+
+struct __attribute__ ((packed)) capture_binary_record_s {
+	// nanoseconds since previous record, gaps longer than 4.29 seconds are split with CAPTURE_RECORD_TIME_ONLY records
+	uint32_t deltaNs;
+	// CSV timestamp is this many doubles away from 'ns / 1e9'
+	int8_t ulpCorrection;
+	// bit per CSV column after timestamp
+	uint8_t columns;
+};
+
+static_assert(sizeof(capture_binary_record_s) == 6);
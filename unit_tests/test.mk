@@ -1,6 +1,8 @@
 FRAMEWORK_SRC_CPP = test-framework/unit_test_framework.cpp \
 	test-framework/engine_test_helper.cpp \
 	test-framework/logicdata_csv_reader.cpp \
+	test-framework/trigger_capture.cpp \
+	test-framework/capture_binary_file.cpp \
 	boards.cpp \
 	test-framework/test_executor.cpp \
 	test_basic_math/test_find_index.cpp \
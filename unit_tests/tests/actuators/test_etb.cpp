@@ -250,6 +250,41 @@ TEST(etb, initializationNoThrottles) {
 	initElectronicThrottle();
 }
 
+TEST(etb, reinitOnSensorConfigurationChange) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto previous = std::make_unique<engine_configuration_s>(*engineConfiguration);
+
+	// initial invocation
+	EXPECT_TRUE(isDcConfigurationChanged(nullptr));
+	EXPECT_FALSE(isDcConfigurationChanged(previous.get()));
+
+	// unrelated change does not restart ETB
+	engineConfiguration->tpsAccelLookback += 1;
+	EXPECT_FALSE(isDcConfigurationChanged(previous.get()));
+
+	// TPS removed
+	engineConfiguration->tps1_1AdcChannel = EFI_ADC_NONE;
+	EXPECT_TRUE(isDcConfigurationChanged(previous.get()));
+	engineConfiguration->tps1_1AdcChannel = previous->tps1_1AdcChannel;
+
+	// pedal added
+	engineConfiguration->throttlePedalPositionAdcChannel = EFI_ADC_3;
+	EXPECT_TRUE(isDcConfigurationChanged(previous.get()));
+	engineConfiguration->throttlePedalPositionAdcChannel = previous->throttlePedalPositionAdcChannel;
+
+	// calibration decides if sensor is registered at all
+	engineConfiguration->tpsMax = engineConfiguration->tpsMin;
+	EXPECT_TRUE(isDcConfigurationChanged(previous.get()));
+	engineConfiguration->tpsMax = previous->tpsMax;
+
+	// bit field, compared against active configuration
+	engineConfiguration->useFordRedundantTps = !engineConfiguration->useFordRedundantTps;
+	EXPECT_TRUE(isDcConfigurationChanged(previous.get()));
+	engineConfiguration->useFordRedundantTps = !engineConfiguration->useFordRedundantTps;
+
+	EXPECT_FALSE(isDcConfigurationChanged(previous.get()));
+}
+
 TEST(etb, idlePlumbing) {
 	StrictMock<MockEtb> mocks[ETB_COUNT];
 
@@ -26,6 +26,15 @@ public:
 		CANTxFrame localCopy = *frame;
 		localCopy.DLC = 8;
 		ctfList.emplace_back(localCopy);
+
+		// act as the receiver: multi-frame start frame is acknowledged with "send everything"
+		if ((frame->data8[0] >> 4) == ISO_TP_FRAME_FIRST) {
+			CANRxFrame flowControl;
+			flowControl.DLC = 8;
+			flowControl.data64[0] = 0;
+			flowControl.data8[0] = ISO_TP_FRAME_FLOW_CONTROL << 4;
+			crfList.push_back(flowControl);
+		}
 		return CAN_MSG_OK;
 	}
 
@@ -244,3 +253,257 @@ TEST(testCanSerial, test3_64_4Message) {
 	}, 71, { 64 + 7 });
 }
 
+
+/**
+ * TS side of the bus: ISO-TP peer which follows flow control of the ECU and asks for its own.
+ * Bus time is accounted as if it was a real 500 kbit/s bus.
+ */
+class IsoTpPeer : public ICanStreamer {
+public:
+	// 8 byte standard frame with some stuff bits
+	static constexpr int frameUs = 250;
+	// USB-to-CAN adapter and host OS reacting to flow control frame
+	static constexpr int turnaroundUs = 1000;
+
+	virtual can_msg_t transmit(canmbx_t /*mailbox*/, const CanTxMessage *ctfp, can_sysinterval_t /*timeout*/) override {
+		const uint8_t *data = ctfp->getFrame()->data8;
+		busTimeUs += frameUs;
+
+		switch (data[0] >> 4) {
+		case ISO_TP_FRAME_SINGLE:
+			received.insert(received.end(), data + 1, data + 1 + (data[0] & 0xf));
+			break;
+		case ISO_TP_FRAME_FIRST:
+			receivingNumBytes = (((data[0] & 0xf) << 8) | data[1]) - 6;
+			received.insert(received.end(), data + 2, data + 8);
+			sendFlowControl();
+			break;
+		case ISO_TP_FRAME_CONSECUTIVE: {
+			int numBytes = std::min(receivingNumBytes, 7);
+			received.insert(received.end(), data + 1, data + 1 + numBytes);
+			receivingNumBytes -= numBytes;
+			busTimeUs += getIsoTpSeparationTimeUs(separationTime);
+
+			if (blockSize != 0) {
+				if (framesTillFlowControl == 0) {
+					blockViolationCount++;
+				} else if (--framesTillFlowControl == 0 && receivingNumBytes > 0) {
+					sendFlowControl();
+				}
+			}
+			break;
+		}
+		case ISO_TP_FRAME_FLOW_CONTROL:
+			// ECU is ready for the next block of what we are sending
+			flowControlCount++;
+			ecuBlockSize = data[1];
+			busTimeUs += turnaroundUs;
+			sendBlock(data[1], data[2]);
+			break;
+		}
+
+		return CAN_MSG_OK;
+	}
+
+	virtual can_msg_t receive(canmbx_t /*mailbox*/, CANRxFrame *crfp, can_sysinterval_t /*timeout*/) override {
+		if (toEcu.empty()) {
+			return CAN_MSG_TIMEOUT;
+		}
+		*crfp = toEcu.front();
+		toEcu.pop_front();
+		return CAN_MSG_OK;
+	}
+
+	void send(const std::vector<uint8_t> & packet) {
+		sending = packet;
+		sendingOffset = 6;
+		sendingIndex = 1;
+
+		CANRxFrame frame = makeFrame((ISO_TP_FRAME_FIRST << 4) | (packet.size() >> 8), packet.size() & 0xff);
+		memcpy(frame.data8 + 2, packet.data(), 6);
+		queue(frame);
+	}
+
+	double getBytesPerSecond(size_t numBytes) const {
+		return numBytes * 1e6 / busTimeUs;
+	}
+
+	// flow control we answer with when ECU is sending
+	int blockSize = 0;
+	int separationTime = 0;
+
+	std::vector<uint8_t> received;
+	// in both directions
+	int flowControlCount = 0;
+	// consecutive frames ECU has sent without waiting for our flow control
+	int blockViolationCount = 0;
+	// what ECU has asked for while receiving
+	int ecuBlockSize = -1;
+	size_t maxQueuedToEcu = 0;
+	int64_t busTimeUs = 0;
+
+private:
+	static CANRxFrame makeFrame(uint8_t byte0, uint8_t byte1 = 0, uint8_t byte2 = 0) {
+		CANRxFrame frame;
+		frame.DLC = 8;
+		frame.data64[0] = 0;
+		frame.data8[0] = byte0;
+		frame.data8[1] = byte1;
+		frame.data8[2] = byte2;
+		return frame;
+	}
+
+	void queue(const CANRxFrame & frame) {
+		toEcu.push_back(frame);
+		maxQueuedToEcu = std::max(maxQueuedToEcu, toEcu.size());
+		busTimeUs += frameUs;
+	}
+
+	void sendFlowControl() {
+		flowControlCount++;
+		busTimeUs += turnaroundUs;
+		queue(makeFrame(ISO_TP_FRAME_FLOW_CONTROL << 4, blockSize, separationTime));
+		framesTillFlowControl = blockSize;
+	}
+
+	void sendBlock(int ecuBlockSize, int ecuSeparationTime) {
+		for (int i = 0; sendingOffset < sending.size() && (ecuBlockSize == 0 || i < ecuBlockSize); i++) {
+			if (i > 0) {
+				busTimeUs += getIsoTpSeparationTimeUs(ecuSeparationTime);
+			}
+
+			size_t numBytes = std::min<size_t>(sending.size() - sendingOffset, 7);
+			CANRxFrame frame = makeFrame((ISO_TP_FRAME_CONSECUTIVE << 4) | (sendingIndex++ & 0xf));
+			memcpy(frame.data8 + 1, sending.data() + sendingOffset, numBytes);
+			sendingOffset += numBytes;
+			queue(frame);
+		}
+	}
+
+	std::list<CANRxFrame> toEcu;
+	int receivingNumBytes = 0;
+	int framesTillFlowControl = 0;
+
+	std::vector<uint8_t> sending;
+	size_t sendingOffset = 0;
+	int sendingIndex = 0;
+};
+
+static std::vector<uint8_t> makeTestPage() {
+	std::vector<uint8_t> page(sizeof(persistent_config_s));
+	for (size_t i = 0; i < page.size(); i++) {
+		page[i] = i * 7 + (i >> 8);
+	}
+	return page;
+}
+
+// same sequence as TsChannelBase::writeCrcPacketLarge
+static void writeTsPacket(CanStreamerState & state, const uint8_t *data, size_t size, std::vector<uint8_t> & stream) {
+	uint8_t header[3] = { (uint8_t)(size >> 8), (uint8_t)size, TS_RESPONSE_OK };
+	uint8_t crc[4] = { 0xC1, 0xC2, 0xC3, 0xC4 };
+
+	size_t np = sizeof(header);
+	state.streamAddToTxTimeout(&np, header, 0);
+	np = size;
+	state.streamAddToTxTimeout(&np, data, 0);
+	np = sizeof(crc);
+	state.streamAddToTxTimeout(&np, crc, 0);
+	state.streamFlushTx(0);
+
+	stream.insert(stream.end(), header, header + sizeof(header));
+	stream.insert(stream.end(), data, data + size);
+	stream.insert(stream.end(), crc, crc + sizeof(crc));
+
+	// nobody is draining it in unit tests
+	txCanBuffer.clear();
+}
+
+static void readPage(IsoTpPeer & peer, const char *name) {
+	CanStreamerState state(&peer);
+	std::vector<uint8_t> page = makeTestPage();
+	std::vector<uint8_t> stream;
+
+	int packetCount = 0;
+	for (size_t offset = 0; offset < page.size(); offset += BLOCKING_FACTOR) {
+		writeTsPacket(state, page.data() + offset, std::min<size_t>(BLOCKING_FACTOR, page.size() - offset), stream);
+		packetCount++;
+	}
+
+	EXPECT_TRUE(stream == peer.received);
+	EXPECT_EQ(0, peer.blockViolationCount);
+	// at least one flow control round trip per TS packet, that's the point of large buffer
+	EXPECT_GE(peer.flowControlCount, packetCount);
+	if (peer.blockSize == 0) {
+		EXPECT_EQ(packetCount, peer.flowControlCount);
+	}
+
+	printf("CAN page read (%s): %d bytes in %d ms, %d bytes/s\n", name, (int)page.size(),
+		(int)(peer.busTimeUs / 1000), (int)peer.getBytesPerSecond(page.size()));
+}
+
+TEST(testCanSerial, throughputPageRead) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	{
+		IsoTpPeer peer;
+		readPage(peer, "no blocks");
+		// 7 bytes per 250us frame is the limit
+		EXPECT_GT(peer.getBytesPerSecond(sizeof(persistent_config_s)), 25000);
+	}
+	{
+		IsoTpPeer peer;
+		peer.blockSize = 8;
+		// 500us
+		peer.separationTime = 0xF5;
+		readPage(peer, "blocks of 8, STmin 500us");
+		EXPECT_GT(peer.getBytesPerSecond(sizeof(persistent_config_s)), 7000);
+	}
+}
+
+TEST(testCanSerial, throughputPageWrite) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	IsoTpPeer peer;
+	CanStreamerState state(&peer);
+	std::vector<uint8_t> page = makeTestPage();
+
+	int expectedFlowControlCount = 0;
+	for (size_t offset = 0; offset < page.size(); offset += BLOCKING_FACTOR) {
+		size_t size = std::min<size_t>(BLOCKING_FACTOR, page.size() - offset);
+		std::vector<uint8_t> packet(page.begin() + offset, page.begin() + offset + size);
+		// size, command, page, offset and count in front, CRC at the end
+		packet.insert(packet.begin(), 9, 0);
+		packet.insert(packet.end(), 4, 0);
+		peer.send(packet);
+
+		std::vector<uint8_t> rxbuf(packet.size());
+		size_t np = rxbuf.size();
+		state.streamReceiveTimeout(&np, rxbuf.data(), 0);
+		ASSERT_EQ(packet.size(), np);
+		EXPECT_TRUE(packet == rxbuf);
+
+		int consecutiveFrames = (packet.size() - 6 + 6) / 7;
+		expectedFlowControlCount += 1 + (consecutiveFrames - 1) / state.rxBlockSize;
+		txCanBuffer.clear();
+	}
+
+	EXPECT_EQ(CAN_ISO_TP_RX_BLOCK_SIZE, peer.ecuBlockSize);
+	EXPECT_EQ(expectedFlowControlCount, peer.flowControlCount);
+	// CanTsListener would never have to queue more than it is able to
+	EXPECT_LE(peer.maxQueuedToEcu, (size_t)CAN_FIFO_FRAME_SIZE);
+	EXPECT_EQ(0, state.rxFifoBuf.getCount());
+
+	printf("CAN page write: %d bytes in %d ms, %d bytes/s\n", (int)page.size(),
+		(int)(peer.busTimeUs / 1000), (int)peer.getBytesPerSecond(page.size()));
+	EXPECT_GT(peer.getBytesPerSecond(page.size()), 20000);
+}
+
+TEST(testCanSerial, separationTime) {
+	EXPECT_EQ(0, getIsoTpSeparationTimeUs(0));
+	EXPECT_EQ(127000, getIsoTpSeparationTimeUs(0x7F));
+	EXPECT_EQ(100, getIsoTpSeparationTimeUs(0xF1));
+	EXPECT_EQ(900, getIsoTpSeparationTimeUs(0xF9));
+	// reserved
+	EXPECT_EQ(127000, getIsoTpSeparationTimeUs(0x80));
+	EXPECT_EQ(127000, getIsoTpSeparationTimeUs(0xFA));
+}
@@ -145,7 +145,7 @@ TEST(misc, testAngleResolver) {
 
 	ASSERT_EQ( 10,  ts->getSize()) << "shape size";
 
-	TriggerWaveform t;
+	TriggerWaveformFull t;
 	configureFordAspireTriggerWaveform(&t);
 }
 
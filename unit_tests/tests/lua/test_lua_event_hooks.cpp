@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "rusefi_lua.h"
+#include "lua_event_hooks.h"
+
+static lua_State* setupEventHooks(const char* script) {
+	lua_State* l = luaL_newstate();
+	configureLuaEventHooks(l);
+
+	if (0 != luaL_dostring(l, script)) {
+		ADD_FAILURE() << lua_tostring(l, -1);
+	}
+
+	return l;
+}
+
+static lua_Number getGlobalNumber(lua_State* l, const char* name) {
+	lua_getglobal(l, name);
+	lua_Number result = lua_tonumber(l, -1);
+	lua_pop(l, 1);
+	return result;
+}
+
+TEST(LuaEventHooks, TimersRunAtTheirOwnRate) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	lua_State* l = setupEventHooks(R"(
+		fast = 0
+		slow = 0
+		every(10, function() fast = fast + 1 end)
+		every(1000, function() slow = slow + 1 end)
+	)");
+
+	for (int i = 0; i < 100; i++) {
+		eth.moveTimeForwardMs(10);
+		dispatchLuaEventHooks(l, getTimeNowNt());
+	}
+
+	EXPECT_EQ(100, getGlobalNumber(l, "fast"));
+	EXPECT_EQ(1, getGlobalNumber(l, "slow"));
+
+	efitick_t nextNt;
+	ASSERT_TRUE(getNextLuaTimerNt(nextNt));
+	EXPECT_EQ(getTimeNowNt() + MS2NT(10), nextNt);
+
+	// long delay does not produce a burst of catch up invocations
+	eth.moveTimeForwardMs(500);
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(101, getGlobalNumber(l, "fast"));
+
+	lua_close(l);
+}
+
+TEST(LuaEventHooks, EngineCycle) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	lua_State* l = setupEventHooks(R"(
+		cycles = 0
+		calls = 0
+		onEngineCycle(function(count)
+			cycles = cycles + count
+			calls = calls + 1
+		end)
+	)");
+
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(0, getGlobalNumber(l, "calls"));
+
+	engine->rpmCalculator.onNewEngineCycle();
+	engine->rpmCalculator.onNewEngineCycle();
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(1, getGlobalNumber(l, "calls"));
+	EXPECT_EQ(2, getGlobalNumber(l, "cycles"));
+
+	lua_close(l);
+}
+
+TEST(LuaEventHooks, SensorChange) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	Sensor::setMockValue(SensorType::Clt, 20);
+
+	lua_State* l = setupEventHooks(R"(
+		calls = 0
+		onSensorChange("CLT", 1, function(value)
+			clt = value
+			calls = calls + 1
+		end)
+	)");
+
+	// first value is reported right away
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(1, getGlobalNumber(l, "calls"));
+	EXPECT_EQ(20, getGlobalNumber(l, "clt"));
+
+	// below threshold
+	Sensor::setMockValue(SensorType::Clt, 20.5);
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(1, getGlobalNumber(l, "calls"));
+
+	Sensor::setMockValue(SensorType::Clt, 22);
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(2, getGlobalNumber(l, "calls"));
+	EXPECT_EQ(22, getGlobalNumber(l, "clt"));
+
+	// failed sensor is reported as nil
+	Sensor::resetMockValue(SensorType::Clt);
+	dispatchLuaEventHooks(l, getTimeNowNt());
+	EXPECT_EQ(3, getGlobalNumber(l, "calls"));
+	lua_getglobal(l, "clt");
+	EXPECT_TRUE(lua_isnil(l, -1));
+
+	lua_close(l);
+}
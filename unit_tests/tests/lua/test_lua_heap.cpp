@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "rusefi_lua.h"
+#include "lua_heap.h"
+
+alignas(8) static char heapBuffer[4096];
+
+static void* alloc(LuaHeap& heap, size_t size) {
+	return heap.realloc(nullptr, 0, size);
+}
+
+TEST(LuaHeap, FreeMergesNeighbours) {
+	LuaHeap heap(heapBuffer);
+	size_t wholeHeap = heap.largestFree();
+
+	void* a = alloc(heap, 20);
+	void* b = alloc(heap, 100);
+	void* c = alloc(heap, 20);
+	ASSERT_NE(nullptr, a);
+	ASSERT_NE(nullptr, b);
+	ASSERT_NE(nullptr, c);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(b) % 8);
+	EXPECT_FLOAT_EQ(0, heap.fragmentationPercent());
+
+	heap.realloc(b, 100, 0);
+	EXPECT_GT(heap.fragmentationPercent(), 0);
+
+	// same size class goes right back into the hole
+	void* d = alloc(heap, 100);
+	EXPECT_EQ(b, d);
+
+	heap.realloc(a, 20, 0);
+	heap.realloc(d, 100, 0);
+	heap.realloc(c, 20, 0);
+	EXPECT_EQ(0, heap.used());
+	EXPECT_EQ(wholeHeap, heap.largestFree());
+	EXPECT_FLOAT_EQ(0, heap.fragmentationPercent());
+	EXPECT_GT(heap.peakUsed(), 140);
+}
+
+TEST(LuaHeap, ReallocInPlace) {
+	LuaHeap heap(heapBuffer);
+
+	char* a = static_cast<char*>(alloc(heap, 200));
+	memset(a, 0x55, 200);
+	size_t usedBefore = heap.used();
+
+	EXPECT_EQ(a, heap.realloc(a, 200, 50));
+	EXPECT_EQ(usedBefore - 144, heap.used());
+
+	// grows back into the tail it has just released
+	EXPECT_EQ(a, heap.realloc(a, 50, 180));
+
+	void* b = alloc(heap, 16);
+	ASSERT_NE(nullptr, b);
+
+	// no room right after it any more: moved, content preserved
+	char* moved = static_cast<char*>(heap.realloc(a, 180, 1000));
+	ASSERT_NE(nullptr, moved);
+	EXPECT_NE(a, moved);
+	for (int i = 0; i < 50; i++) {
+		EXPECT_EQ(0x55, moved[i]);
+	}
+}
+
+TEST(LuaHeap, OutOfMemory) {
+	LuaHeap heap(heapBuffer);
+
+	char* a = static_cast<char*>(alloc(heap, 100));
+	a[0] = 42;
+
+	EXPECT_EQ(nullptr, alloc(heap, sizeof(heapBuffer)));
+	// failed realloc leaves the block alone
+	EXPECT_EQ(nullptr, heap.realloc(a, 100, sizeof(heapBuffer)));
+	EXPECT_EQ(42, a[0]);
+	EXPECT_EQ(2, heap.failedAllocations());
+}
+
+static void* heapAlloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+	return reinterpret_cast<LuaHeap*>(ud)->realloc(ptr, osize, nsize);
+}
+
+static size_t collectAndMeasure(lua_State* l, LuaHeap& heap) {
+	lua_gc(l, LUA_GCCOLLECT, 0);
+	lua_gc(l, LUA_GCCOLLECT, 0);
+	return heap.used();
+}
+
+TEST(LuaHeap, Soak) {
+	// about what smaller boards have as LUA_USER_HEAP
+	static char soakBuffer[25000];
+	LuaHeap heap(soakBuffer);
+
+	lua_State* l = lua_newstate(heapAlloc, &heap);
+	ASSERT_NE(nullptr, l);
+	// same GC settings as firmware
+	lua_gc(l, LUA_GCINC, 50, 1000, 9);
+
+	auto script = R"(
+		local history = {}
+		local counter = 0
+
+		function onTick()
+			counter = counter + 1
+			local key = "k" .. (counter % 50)
+			local adder = function(x) return x + counter end
+			-- fixed width so that live set is the same size at any tick
+			history[key] = { counter, "v" .. (1000 + counter % 1000), adder(1) }
+		end
+	)";
+	ASSERT_EQ(0, luaL_dostring(l, script));
+
+	size_t usedAfterWarmup = 0;
+	for (int tick = 0; tick < 1000000; tick++) {
+		lua_getglobal(l, "onTick");
+		ASSERT_EQ(0, lua_pcall(l, 0, 0, 0)) << "tick " << tick;
+
+		if (tick == 100000) {
+			usedAfterWarmup = collectAndMeasure(l, heap);
+		}
+	}
+
+	// live data does not grow and heap never ran dry
+	EXPECT_LE(collectAndMeasure(l, heap), usedAfterWarmup);
+	EXPECT_EQ(0, heap.failedAllocations());
+	EXPECT_LT(heap.peakUsed(), heap.size());
+
+	lua_close(l);
+	EXPECT_EQ(0, heap.used());
+}
@@ -0,0 +1,128 @@
+/*
+ * @file test_periodic_executor.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "periodic_executor.h"
+
+// CH_CFG_ST_FREQUENCY is 1MHz in unit tests
+#define PERIOD_100HZ 10000
+
+class CountingJob : public PeriodicJob {
+public:
+	CountingJob(float frequencyHz) : PeriodicJob("test", PeriodicLane::Low, frequencyHz) { }
+
+	int count = 0;
+	int nextPeriodMs = 0;
+
+private:
+	void PeriodicTask(efitick_t) override {
+		count++;
+		if (nextPeriodMs) {
+			setPeriod(nextPeriodMs);
+		}
+	}
+};
+
+TEST(PeriodicExecutor, runsRightAwayThenEveryPeriod) {
+	PeriodicJobList jobs;
+	CountingJob job(100);
+
+	jobs.add(job, 1000);
+	EXPECT_EQ(0, job.count);
+
+	EXPECT_EQ(PERIOD_100HZ, jobs.runDue(1000, 0));
+	EXPECT_EQ(1, job.count);
+
+	// not due yet
+	EXPECT_EQ(PERIOD_100HZ - 1000, jobs.runDue(2000, 0));
+	EXPECT_EQ(1, job.count);
+
+	// running late does not shift the schedule
+	EXPECT_EQ(PERIOD_100HZ - 500, jobs.runDue(1000 + PERIOD_100HZ + 500, 0));
+	EXPECT_EQ(2, job.count);
+	EXPECT_EQ(0, jobs.missedDeadlines);
+}
+
+TEST(PeriodicExecutor, missedDeadlineDoesNotCatchUp) {
+	PeriodicJobList jobs;
+	CountingJob job(100);
+
+	jobs.add(job, 0);
+	jobs.runDue(0, 0);
+
+	// three periods late: one invocation, next one a whole period later
+	EXPECT_EQ(PERIOD_100HZ, jobs.runDue(3 * PERIOD_100HZ + 100, 0));
+	EXPECT_EQ(2, job.count);
+	EXPECT_EQ(1, jobs.missedDeadlines);
+
+	EXPECT_EQ(PERIOD_100HZ, jobs.runDue(4 * PERIOD_100HZ + 100, 0));
+	EXPECT_EQ(3, job.count);
+	EXPECT_EQ(1, jobs.missedDeadlines);
+}
+
+TEST(PeriodicExecutor, soonestJobDefinesSleep) {
+	PeriodicJobList jobs;
+	CountingJob fast(100);
+	CountingJob slow(10);
+
+	jobs.add(fast, 0);
+	jobs.add(slow, 0);
+
+	EXPECT_EQ(PERIOD_100HZ, jobs.runDue(0, 0));
+	EXPECT_EQ(1, fast.count);
+	EXPECT_EQ(1, slow.count);
+
+	for (int i = 1; i < 10; i++) {
+		jobs.runDue(i * PERIOD_100HZ, 0);
+	}
+	EXPECT_EQ(10, fast.count);
+	EXPECT_EQ(1, slow.count);
+
+	jobs.runDue(10 * PERIOD_100HZ, 0);
+	EXPECT_EQ(11, fast.count);
+	EXPECT_EQ(2, slow.count);
+}
+
+TEST(PeriodicExecutor, remove) {
+	PeriodicJobList jobs;
+	CountingJob first(100);
+	CountingJob second(100);
+
+	jobs.add(first, 0);
+	jobs.add(second, 0);
+	// second registration is ignored
+	jobs.add(second, 0);
+	jobs.runDue(0, 0);
+	EXPECT_EQ(1, first.count);
+	EXPECT_EQ(1, second.count);
+
+	jobs.remove(second);
+	jobs.runDue(PERIOD_100HZ, 0);
+	EXPECT_EQ(2, first.count);
+	EXPECT_EQ(1, second.count);
+
+	jobs.remove(first);
+	// nothing to run: maximum sleep
+	EXPECT_EQ(CH_CFG_ST_FREQUENCY, jobs.runDue(2 * PERIOD_100HZ, 0));
+	EXPECT_EQ(2, first.count);
+}
+
+TEST(PeriodicExecutor, periodChangedFromTask) {
+	PeriodicJobList jobs;
+	CountingJob job(100);
+	job.nextPeriodMs = 50;
+
+	jobs.add(job, 0);
+	EXPECT_EQ(50000, jobs.runDue(0, 0));
+	EXPECT_EQ(1, job.count);
+
+	jobs.runDue(PERIOD_100HZ, 0);
+	EXPECT_EQ(1, job.count);
+
+	jobs.runDue(50000, 0);
+	EXPECT_EQ(2, job.count);
+}
@@ -1,10 +1,60 @@
 #include "pch.h"
 
-BigBufferUser getBigBufferCurrentUser();
-
 TEST(BigBuffer, CppMagic) {
   BigBufferHandle h = getBigBuffer(BigBufferUser::ToothLogger);
-  ASSERT_EQ(getBigBufferCurrentUser(), BigBufferUser::ToothLogger);
+  ASSERT_EQ(getBigBufferUsage(BigBufferUser::ToothLogger), BIG_BUFFER_SIZE);
   h = {};
-  ASSERT_EQ(getBigBufferCurrentUser(), BigBufferUser::None);
+  ASSERT_EQ(getBigBufferUsage(BigBufferUser::ToothLogger), 0);
+  ASSERT_EQ(getBigBufferUsage(BigBufferUser::None), BIG_BUFFER_SIZE);
+}
+
+TEST(BigBuffer, TwoUsersAtOnce) {
+  BigBufferHandle toothLogger = getBigBuffer(BigBufferUser::ToothLogger, 5000);
+  ASSERT_TRUE(toothLogger);
+  // rounded up to whole blocks
+  EXPECT_EQ(toothLogger.size(), 20 * BIG_BUFFER_BLOCK_SIZE);
+
+  EXPECT_EQ(getBigBufferLargestFree(), BIG_BUFFER_SIZE - 20 * BIG_BUFFER_BLOCK_SIZE);
+  // whole buffer is not available any more
+  EXPECT_FALSE(getBigBuffer(BigBufferUser::TriggerScope));
+
+  BigBufferHandle perfTrace = getBigBuffer(BigBufferUser::PerfTrace, getBigBufferLargestFree());
+  ASSERT_TRUE(perfTrace);
+  EXPECT_EQ(getBigBufferUsage(BigBufferUser::PerfTrace), BIG_BUFFER_SIZE - 20 * BIG_BUFFER_BLOCK_SIZE);
+  EXPECT_EQ(getBigBufferLargestFree(), 0);
+
+  // partitions do not overlap
+  EXPECT_EQ(toothLogger.get<uint8_t>() + toothLogger.size(), perfTrace.get<uint8_t>());
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(perfTrace.get<uint8_t>()) % sizeof(uint32_t));
+
+  toothLogger = {};
+  EXPECT_EQ(getBigBufferUsage(BigBufferUser::ToothLogger), 0);
+  EXPECT_EQ(getBigBufferLargestFree(), 20 * BIG_BUFFER_BLOCK_SIZE);
+
+  // handle moved away does not release anything
+  BigBufferHandle moved = std::move(perfTrace);
+  EXPECT_FALSE(perfTrace);
+  perfTrace = {};
+  EXPECT_EQ(getBigBufferUsage(BigBufferUser::PerfTrace), BIG_BUFFER_SIZE - 20 * BIG_BUFFER_BLOCK_SIZE);
+
+  moved = {};
+  EXPECT_EQ(getBigBufferUsage(BigBufferUser::None), BIG_BUFFER_SIZE);
+}
+
+TEST(BigBuffer, FreedHoleIsReused) {
+  BigBufferHandle first = getBigBuffer(BigBufferUser::ToothLogger, BIG_BUFFER_BLOCK_SIZE);
+  BigBufferHandle second = getBigBuffer(BigBufferUser::TriggerScope, BIG_BUFFER_BLOCK_SIZE);
+  BigBufferHandle third = getBigBuffer(BigBufferUser::KnockSpectrogram, BIG_BUFFER_BLOCK_SIZE);
+
+  uint8_t* hole = second.get<uint8_t>();
+  second = {};
+
+  // too big for the hole, goes after the last partition
+  BigBufferHandle big = getBigBuffer(BigBufferUser::PerfTrace, 2 * BIG_BUFFER_BLOCK_SIZE);
+  EXPECT_EQ(third.get<uint8_t>() + BIG_BUFFER_BLOCK_SIZE, big.get<uint8_t>());
+  big = {};
+
+  BigBufferHandle small = getBigBuffer(BigBufferUser::PerfTrace, 100);
+  EXPECT_EQ(hole, small.get<uint8_t>());
+  EXPECT_EQ(small.size(), BIG_BUFFER_BLOCK_SIZE);
 }
@@ -0,0 +1,27 @@
+#include "pch.h"
+
+TEST(EngineConfiguration, FieldChanged) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto previous = std::make_unique<engine_configuration_s>(*engineConfiguration);
+
+	// initial invocation
+	EXPECT_TRUE(isConfigurationFieldChanged(nullptr, gearRatio));
+	EXPECT_FALSE(isConfigurationFieldChanged(previous.get(), gearRatio));
+
+	// unrelated change
+	engineConfiguration->tpsAccelLookback += 1;
+	EXPECT_FALSE(isConfigurationFieldChanged(previous.get(), gearRatio));
+	EXPECT_FALSE(isConfigurationFieldChanged(previous.get(), totalGearsCount));
+	EXPECT_TRUE(isConfigurationFieldChanged(previous.get(), tpsAccelLookback));
+
+	// any element of an array
+	engineConfiguration->gearRatio[TCU_GEAR_COUNT - 1] = 7.5;
+	EXPECT_TRUE(isConfigurationFieldChanged(previous.get(), gearRatio));
+	EXPECT_FALSE(isConfigurationFieldChanged(previous.get(), gearRatio[0]));
+	EXPECT_TRUE(isConfigurationFieldRangeChanged(previous.get(), gearRatio[0], gearRatio[TCU_GEAR_COUNT - 1]));
+
+	// any field of a struct
+	engineConfiguration->trigger.customSkippedToothCount++;
+	EXPECT_TRUE(isConfigurationFieldChanged(previous.get(), trigger));
+	EXPECT_FALSE(isConfigurationFieldChanged(previous.get(), trigger.type));
+}
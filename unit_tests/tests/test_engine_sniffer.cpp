@@ -0,0 +1,80 @@
+/*
+ * @file test_engine_sniffer.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "engine_sniffer.h"
+extern WaveChart waveChart;
+
+static std::string recordChart(bool isBinary) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	waveChart.setBinaryMode(isBinary);
+	EXPECT_EQ(isBinary, waveChart.isBinaryMode());
+
+	eth.fireTriggerEvents2(/*count*/10, /*duration*/50);
+	int size = waveChart.getSize();
+	EXPECT_TRUE(size > 10);
+
+	waveChart.publish();
+	std::string result = waveChart.getChartText();
+
+	// big buffer partition goes back
+	waveChart.setBinaryMode(false);
+	return result;
+}
+
+TEST(EngineSniffer, binaryDecodesToSameText) {
+	std::string text = recordChart(false);
+	std::string binary = recordChart(true);
+
+	EXPECT_EQ(text, binary);
+	EXPECT_EQ(0, getBigBufferUsage(BigBufferUser::EngineSniffer));
+}
+
+TEST(EngineSniffer, binaryNeedsBigBuffer) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	BigBufferHandle busy = getBigBuffer(BigBufferUser::ToothLogger);
+
+	// stays in text mode
+	waveChart.setBinaryMode(true);
+	EXPECT_FALSE(waveChart.isBinaryMode());
+}
+
+TEST(EngineSniffer, binaryChartHonoursChartSize) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engineConfiguration->engineChartSize = 20;
+	waveChart.setBinaryMode(true);
+	ASSERT_TRUE(waveChart.isBinaryMode());
+
+	eth.fireTriggerEvents2(/*count*/30, /*duration*/10);
+	EXPECT_EQ(20, waveChart.getSize());
+
+	waveChart.publish();
+	// every recorded event made it into the text, each has three delimiters
+	std::string text = waveChart.getChartText();
+	EXPECT_EQ(3 * 20, std::count(text.begin(), text.end(), '!'));
+
+	waveChart.setBinaryMode(false);
+}
+
+TEST(EngineSniffer, binaryChartHoldsAsManyEventsAsText) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engineConfiguration->engineChartSize = 400;
+	waveChart.setBinaryMode(true);
+	ASSERT_TRUE(waveChart.isBinaryMode());
+
+	eth.fireTriggerEvents2(/*count*/200, /*duration*/10);
+	EXPECT_EQ(400, waveChart.getSize());
+
+	waveChart.publish();
+	std::string text = waveChart.getChartText();
+	EXPECT_EQ(3 * 400, std::count(text.begin(), text.end(), '!'));
+	// one chart, however many pieces it took
+	EXPECT_EQ(0u, text.find(PROTOCOL_ENGINE_SNIFFER LOG_DELIMITER));
+	EXPECT_EQ(2, std::count(text.begin(), text.end(), LOG_DELIMITER[0]));
+
+	waveChart.setBinaryMode(false);
+}
@@ -213,3 +213,35 @@ TEST_F(EventQueueRemoveTest, removeNotPresent) {
 	ASSERT_EQ(&s3, dut.getElementAtIndexForUnitText(2));
 	ASSERT_EQ(nullptr, dut.getElementAtIndexForUnitText(3));
 }
+
+TEST(EventQueue, statistics) {
+	EventQueue eq;
+	scheduling_s s1, s2, s3;
+
+	ASSERT_EQ(0, eq.getMaxSize());
+	ASSERT_EQ(0, eq.getMaxLatenessNt());
+
+	eq.insertTask(&s1, 100, callback);
+	eq.insertTask(&s2, 200, callback);
+	eq.insertTask(&s3, 300, callback);
+	eq.remove(&s2);
+	ASSERT_EQ(2, eq.size());
+	ASSERT_EQ(3, eq.getMaxSize());
+
+	// s1 is executed 50 ticks late, s3 right on time
+	eq.executeAll(150);
+	ASSERT_EQ(50, eq.getMaxLatenessNt());
+	eq.executeAll(300);
+	ASSERT_EQ(50, eq.getMaxLatenessNt());
+	ASSERT_EQ(0, eq.size());
+
+	eq.resetStatistics();
+	ASSERT_EQ(0, eq.getMaxSize());
+	ASSERT_EQ(0, eq.getMaxLatenessNt());
+
+	eq.insertTask(&s1, 100, callback);
+	ASSERT_EQ(1, eq.getMaxSize());
+	eq.clear();
+	eq.insertTask(&s1, 100, callback);
+	ASSERT_EQ(1, eq.getMaxSize());
+}
@@ -0,0 +1,155 @@
+#include "pch.h"
+
+#include "settings_journal.h"
+
+#define TEST_CHUNK_SIZE 16
+#define TEST_CHUNK_COUNT 4
+// last chunk is shorter
+#define TEST_SETTINGS_SIZE (TEST_CHUNK_SIZE * TEST_CHUNK_COUNT - 5)
+
+/**
+ * Chunk records in RAM, transaction is either committed as a whole or not at all like MFS does
+ */
+class TestChunkStore : public SettingsChunkStore {
+public:
+	StorageStatus writeChunks(const uint8_t *ptr, size_t size, size_t chunkSize, uint32_t dirtyMask) override {
+		lastDirtyMask = dirtyMask;
+
+		uint8_t transaction[TEST_SETTINGS_SIZE];
+		memcpy(transaction, stored, sizeof(transaction));
+
+		int chunksWritten = 0;
+		for (size_t i = 0; i * chunkSize < size; i++) {
+			if (dirtyMask & (1 << i)) {
+				if (chunksWritten == powerLossAfterChunks) {
+					// uncommitted transaction is dropped on next mount
+					return StorageStatus::Failed;
+				}
+				memcpy(transaction + i * chunkSize, ptr + i * chunkSize, minI(chunkSize, size - i * chunkSize));
+				chunksWritten++;
+			}
+		}
+
+		memcpy(stored, transaction, sizeof(stored));
+		isEmpty = false;
+		return StorageStatus::Ok;
+	}
+
+	StorageStatus readChunks(uint8_t *ptr, size_t size, size_t /*chunkSize*/) override {
+		if (isEmpty) {
+			return StorageStatus::NotFound;
+		}
+		memcpy(ptr, stored, size);
+		return StorageStatus::Ok;
+	}
+
+	uint8_t stored[TEST_SETTINGS_SIZE] = {};
+	bool isEmpty = true;
+	uint32_t lastDirtyMask = 0;
+	// -1 for no power loss
+	int powerLossAfterChunks = -1;
+};
+
+static void fillSettings(uint8_t *settings, uint8_t seed) {
+	for (size_t i = 0; i < TEST_SETTINGS_SIZE; i++) {
+		settings[i] = seed + i;
+	}
+}
+
+TEST(SettingsJournal, ChunkedBurn) {
+	TestChunkStore store;
+	uint8_t settings[TEST_SETTINGS_SIZE];
+	fillSettings(settings, 0);
+
+	SettingsJournal journal(store, settings, sizeof(settings), TEST_CHUNK_SIZE);
+	EXPECT_EQ(journal.getChunkCount(), TEST_CHUNK_COUNT);
+
+	// nothing known about storage yet: all chunks
+	EXPECT_EQ(journal.getChangedChunks(), 0b1111);
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+	EXPECT_EQ(store.lastDirtyMask, 0b1111);
+	EXPECT_EQ(0, memcmp(store.stored, settings, sizeof(settings)));
+
+	// nothing changed
+	EXPECT_EQ(journal.getChangedChunks(), 0);
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+	EXPECT_EQ(store.lastDirtyMask, 0);
+
+	// one byte in the middle of third chunk
+	settings[2 * TEST_CHUNK_SIZE + 3] = 0xAA;
+	EXPECT_EQ(journal.getChangedChunks(), 0b0100);
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+	EXPECT_EQ(store.lastDirtyMask, 0b0100);
+	EXPECT_EQ(0, memcmp(store.stored, settings, sizeof(settings)));
+
+	// write across chunk boundary, and the short last chunk
+	settings[TEST_CHUNK_SIZE - 1] = 0x55;
+	settings[TEST_CHUNK_SIZE] = 0x55;
+	settings[TEST_SETTINGS_SIZE - 1] = 0x55;
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+	EXPECT_EQ(store.lastDirtyMask, 0b1011);
+	EXPECT_EQ(0, memcmp(store.stored, settings, sizeof(settings)));
+}
+
+TEST(SettingsJournal, ReadMeansStored) {
+	TestChunkStore store;
+	fillSettings(store.stored, 7);
+	store.isEmpty = false;
+
+	uint8_t settings[TEST_SETTINGS_SIZE] = {};
+	SettingsJournal journal(store, settings, sizeof(settings), TEST_CHUNK_SIZE);
+
+	ASSERT_EQ(journal.read(), StorageStatus::Ok);
+	EXPECT_EQ(0, memcmp(store.stored, settings, sizeof(settings)));
+
+	EXPECT_EQ(journal.getChangedChunks(), 0);
+	settings[TEST_CHUNK_SIZE] = 0;
+	EXPECT_EQ(journal.getChangedChunks(), 0b0010);
+}
+
+TEST(SettingsJournal, NothingToRead) {
+	TestChunkStore store;
+	uint8_t settings[TEST_SETTINGS_SIZE] = {};
+	SettingsJournal journal(store, settings, sizeof(settings), TEST_CHUNK_SIZE);
+
+	EXPECT_EQ(journal.read(), StorageStatus::NotFound);
+	// for example settings from older single record format: everything goes on first burn
+	EXPECT_EQ(journal.getChangedChunks(), 0b1111);
+}
+
+TEST(SettingsJournal, RecoveryAfterInterruptedBurn) {
+	TestChunkStore store;
+	uint8_t settings[TEST_SETTINGS_SIZE];
+	fillSettings(settings, 0);
+
+	SettingsJournal journal(store, settings, sizeof(settings), TEST_CHUNK_SIZE);
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+
+	uint8_t oldSettings[TEST_SETTINGS_SIZE];
+	memcpy(oldSettings, settings, sizeof(oldSettings));
+
+	// second and fourth chunks change, power is lost after first of them was written
+	settings[TEST_CHUNK_SIZE] = 0xAA;
+	settings[3 * TEST_CHUNK_SIZE] = 0xAA;
+	store.powerLossAfterChunks = 1;
+	EXPECT_EQ(journal.write(), StorageStatus::Failed);
+
+	{
+		// next boot: old settings as a whole, no mix of old and new chunks
+		uint8_t readBack[TEST_SETTINGS_SIZE] = {};
+		SettingsJournal bootJournal(store, readBack, sizeof(readBack), TEST_CHUNK_SIZE);
+		ASSERT_EQ(bootJournal.read(), StorageStatus::Ok);
+		EXPECT_EQ(0, memcmp(readBack, oldSettings, sizeof(readBack)));
+	}
+
+	// we did not reboot: since we do not know what made it to storage everything is written
+	store.powerLossAfterChunks = -1;
+	settings[3 * TEST_CHUNK_SIZE] = oldSettings[3 * TEST_CHUNK_SIZE];
+	EXPECT_EQ(journal.getChangedChunks(), 0b1111);
+	ASSERT_EQ(journal.write(), StorageStatus::Ok);
+	EXPECT_EQ(store.lastDirtyMask, 0b1111);
+	EXPECT_EQ(0, memcmp(store.stored, settings, sizeof(settings)));
+
+	// and we are back to chunked burns
+	EXPECT_EQ(journal.getChangedChunks(), 0);
+}
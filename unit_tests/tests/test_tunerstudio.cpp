@@ -1,6 +1,9 @@
 #include "pch.h"
 #include "tunerstudio.h"
 #include "tunerstudio_io.h"
+#include "ts_config_staging.h"
+#include "ts_page_crc.h"
+#include "live_data.h"
 
 static uint8_t st5TestBuffer[16000];
 
@@ -67,6 +70,71 @@ TEST(binary, testWriteCrc) {
 	assertCrcPacket(test);
 }
 
+TEST(binary, testWriteCrcFragments) {
+	BufferTsChannel test;
+
+	// reference: the same payload in one piece
+	const uint8_t payload[] = { '1', '2', 0, 0, 0, '3' };
+	test.reset();
+	test.writeCrcPacket(CODE, payload, sizeof(payload));
+	std::vector<uint8_t> expected(st5TestBuffer, st5TestBuffer + test.writeIdx);
+
+	TsFragment fragments[] = {
+		{ payload, 2 },
+		// zeros
+		{ nullptr, 3 },
+		{ payload + 5, 1 },
+	};
+	test.reset();
+	test.writeCrcPacketFragments(CODE, fragments, efi::size(fragments));
+	EXPECT_TRUE(expected == std::vector<uint8_t>(st5TestBuffer, st5TestBuffer + test.writeIdx));
+
+	// live data staging does not change anything on the wire
+	test.reset();
+	uint32_t crc = test.writePacketHeader(CODE, sizeof(payload));
+	crc = test.writeLiveDataFragment(crc, payload, sizeof(payload));
+	test.writePacketFooter(crc);
+	EXPECT_TRUE(expected == std::vector<uint8_t>(st5TestBuffer, st5TestBuffer + test.writeIdx));
+}
+
+TEST(binary, testWriteCrcFragmentsLongerThanScratchBuffer) {
+	BufferTsChannel test;
+
+	static uint8_t payload[3 * BLOCKING_FACTOR];
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = i * 3;
+	}
+	ASSERT_GT(sizeof(payload), sizeof(test.scratchBuffer));
+
+	TsFragment fragment = { payload, sizeof(payload) };
+	test.reset();
+	test.writeCrcPacketFragments(CODE, &fragment, 1);
+
+	ASSERT_EQ(sizeof(payload) + 7, test.writeIdx);
+	EXPECT_EQ(0, memcmp(payload, &st5TestBuffer[3], sizeof(payload)));
+	// CRC covers response code and payload
+	uint32_t crc = SWAP_UINT32(crc32(&st5TestBuffer[2], sizeof(payload) + 1));
+	EXPECT_EQ(0, memcmp(&crc, &st5TestBuffer[3 + sizeof(payload)], sizeof(crc)));
+}
+
+TEST(TunerstudioCommands, outputChannelsFromFragments) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	BufferTsChannel channel;
+	TunerStudio instance;
+
+	uint8_t expected[300];
+	channel.reset();
+	instance.cmdOutputChannels(&channel, 100, sizeof(expected));
+	copyRange(expected, getLiveDataFragments(), 100, sizeof(expected));
+	ASSERT_EQ(sizeof(expected) + 7, channel.writeIdx);
+	EXPECT_EQ(0, memcmp(expected, &st5TestBuffer[3], sizeof(expected)));
+
+	// whole live data at once does not fit into scratchBuffer
+	channel.reset();
+	instance.cmdOutputChannels(&channel, 0, TS_TOTAL_OUTPUT_SIZE);
+	EXPECT_EQ(TS_TOTAL_OUTPUT_SIZE + 7, channel.writeIdx);
+}
+
 TEST(TunerstudioCommands, writeChunkEngineConfig) {
 	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
 	::testing::NiceMock<MockTsChannel> channel;
@@ -82,5 +150,158 @@ TEST(TunerstudioCommands, writeChunkEngineConfig) {
 	TunerStudio instance;
 	instance.handleWriteChunkCommand(&channel, 0, 100, 1, &val);
 
+	// staged, not visible to live configuration until published
+	EXPECT_EQ(configBytes[100], 0);
+
+	// committed by TS thread, published at fast callback safe point
+	commitStagedConfigWrites();
+	EXPECT_EQ(configBytes[100], 0);
+	publishStagedConfigWrites();
 	EXPECT_EQ(configBytes[100], 50);
 }
+
+TEST(TunerstudioCommands, writeChunksPublishedAtOnce) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	::testing::NiceMock<MockTsChannel> channel;
+
+	// table written by TS in a number of chunks
+	constexpr size_t tableOffset = 200;
+	constexpr size_t chunkSize = 100;
+	constexpr size_t chunkCount = 4;
+	uint8_t* table = reinterpret_cast<uint8_t*>(config) + tableOffset;
+	memset(table, 0, chunkSize * chunkCount);
+
+	uint8_t chunk[chunkSize];
+	memset(chunk, 7, sizeof(chunk));
+
+	// reader at fast callback safe point sees either old or new table, never a mix
+	auto isTableAll = [&](uint8_t value) {
+		for (size_t i = 0; i < chunkSize * chunkCount; i++) {
+			if (table[i] != value) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	TunerStudio instance;
+	for (size_t i = 0; i < chunkCount; i++) {
+		instance.handleWriteChunkCommand(&channel, 0, tableOffset + i * chunkSize, chunkSize, chunk);
+
+		// fast callback runs in between TS writes while TS is still writing
+		advanceTimeUs(MS2US(TS_CONFIG_STAGING_QUIET_MS / 2));
+		publishStagedConfigWrites();
+		EXPECT_TRUE(isTableAll(0)) << "after chunk " << i;
+	}
+
+	// later write of the same byte wins
+	uint8_t overwrite = 4;
+	instance.handleWriteChunkCommand(&channel, 0, tableOffset + 1, sizeof(overwrite), &overwrite);
+
+	advanceTimeUs(MS2US(TS_CONFIG_STAGING_QUIET_MS + 1));
+	publishStagedConfigWrites();
+	EXPECT_EQ(table[1], 4);
+	table[1] = 7;
+	EXPECT_TRUE(isTableAll(7));
+}
+
+TEST(TunerstudioCommands, writeChunkStagingOverflow) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	uint8_t* configBytes = reinterpret_cast<uint8_t*>(config);
+	constexpr size_t chunkSize = BLOCKING_FACTOR;
+	constexpr size_t chunkCount = TS_CONFIG_STAGING_SIZE / chunkSize + 1;
+	memset(configBytes + 1000, 0, chunkSize * chunkCount);
+
+	uint8_t chunk[chunkSize];
+	memset(chunk, 9, sizeof(chunk));
+
+	for (size_t i = 0; i < chunkCount - 1; i++) {
+		EXPECT_TRUE(stageConfigWrite(1000 + i * chunkSize, chunkSize, chunk));
+	}
+	// no room for the last chunk of the table: whole batch is dropped, nothing is published
+	EXPECT_FALSE(stageConfigWrite(1000 + (chunkCount - 1) * chunkSize, chunkSize, chunk));
+
+	commitStagedConfigWrites();
+	publishStagedConfigWrites();
+	for (size_t i = 0; i < chunkSize * chunkCount; i++) {
+		ASSERT_EQ(configBytes[1000 + i], 0);
+	}
+}
+
+TEST(TunerstudioCommands, pageCrcCache) {
+	// not a multiple of block size
+	static uint8_t page[4 * TS_PAGE_CRC_BLOCK_SIZE - 24];
+	for (size_t i = 0; i < sizeof(page); i++) {
+		page[i] = i * 7;
+	}
+
+	PageCrcCache cache(sizeof(page));
+	EXPECT_EQ(crc32(page, sizeof(page)), cache.get(page, 0, sizeof(page)));
+	EXPECT_EQ(4, cache.computeCounter);
+
+	// everything from cache
+	EXPECT_EQ(crc32(page, sizeof(page)), cache.get(page, 0, sizeof(page)));
+	EXPECT_EQ(crc32(page + 10, 700), cache.get(page, 10, 700));
+	EXPECT_EQ(4, cache.computeCounter);
+
+	// only touched block is read again
+	page[300] = 1;
+	cache.invalidate(300, 1);
+	EXPECT_EQ(crc32(page, sizeof(page)), cache.get(page, 0, sizeof(page)));
+	EXPECT_EQ(5, cache.computeCounter);
+
+	// write we were not told about is picked up by round robin refresh
+	page[600] = 1;
+	for (int i = 0; i < 4; i++) {
+		cache.update(page, 0);
+	}
+	EXPECT_EQ(crc32(page, sizeof(page)), cache.get(page, 0, sizeof(page)));
+
+	// missing blocks are computed ahead of time
+	cache.invalidateAll();
+	cache.update(page, 4);
+	int computeCounter = cache.computeCounter;
+	EXPECT_EQ(crc32(page, sizeof(page)), cache.get(page, 0, sizeof(page)));
+	EXPECT_EQ(computeCounter, cache.computeCounter);
+}
+
+TEST(TunerstudioCommands, pageCrcAfterWrites) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	::testing::NiceMock<MockTsChannel> channel;
+	TunerStudio instance;
+
+	// previous tests leave their configuration behind
+	invalidateConfigPageCrc(0, TOTAL_CONFIG_SIZE);
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+
+	uint8_t value = 0x5A;
+	instance.handleWriteChunkCommand(&channel, 0, 1000, sizeof(value), &value);
+	commitStagedConfigWrites();
+	publishStagedConfigWrites();
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+
+	// console, Lua and such
+	engineConfiguration->cylindersCount++;
+	invalidateConfigFieldCrc(engineConfiguration->cylindersCount);
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+}
+
+TEST(TunerstudioCommands, pageCrcKeptOnBurn) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	// first burn could wipe leftovers after string terminators
+	onBurnRequest();
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+
+	int computeCounter = getConfigPageCrcComputeCounterForUnitTests();
+	onBurnRequest();
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+	EXPECT_EQ(computeCounter, getConfigPageCrcComputeCounterForUnitTests());
+
+	// string with garbage after terminator only invalidates its own blocks
+	engineConfiguration->vehicleName[sizeof(vehicle_info_t) - 1] = 'x';
+	onBurnRequest();
+	EXPECT_EQ(crc32(config, TOTAL_CONFIG_SIZE), getConfigPageCrc(0, TOTAL_CONFIG_SIZE));
+	EXPECT_GE(computeCounter + 2, getConfigPageCrcComputeCounterForUnitTests());
+}
@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include "histogram.h"
+#include "fast_crc32.h"
 
 #include "malfunction_central.h"
 #include "cli_registry.h"
@@ -59,6 +60,41 @@ TEST(util, crc) {
 	ASSERT_NEAR(0x4775a7b1, c, EPS4D) << "crc32 line inc";
 }
 
+TEST(util, crc32SlicingBy8) {
+	ASSERT_EQ(0xCBF43926u, crc32SlicingBy8Inc("123456789", 0, 9));
+
+	uint8_t data[100];
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 37 + 11;
+	}
+
+	// all lengths and misalignments around one 8 byte step
+	for (size_t start = 0; start < 9; start++) {
+		for (size_t size = 0; start + size <= sizeof(data); size++) {
+			ASSERT_EQ(crc32(data + start, size), crc32SlicingBy8Inc(data + start, 0, size)) << start << "/" << size;
+		}
+	}
+
+	uint32_t c = crc32SlicingBy8Inc(data, 0, 13);
+	c = crc32SlicingBy8Inc(data + 13, c, sizeof(data) - 13);
+	ASSERT_EQ(crc32(data, sizeof(data)), c);
+
+	ASSERT_EQ(crc32(data, sizeof(data)), fastCrc32(data, sizeof(data)));
+}
+
+TEST(util, crc32Combine) {
+	uint8_t data[600];
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 13 + 5;
+	}
+
+	for (size_t split : { 0, 1, 7, 256, 599, 600 }) {
+		uint32_t head = crc32(data, split);
+		uint32_t tail = crc32(data + split, sizeof(data) - split);
+		ASSERT_EQ(crc32(data, sizeof(data)), crc32Combine(head, tail, crc32ZerosOperator(sizeof(data) - split))) << split;
+	}
+}
+
 TEST(util, histogram) {
 	initHistogramsModule();
 
@@ -20,6 +20,8 @@ TESTS_SRC_CPP = \
 	tests/trigger/test_real_cas_24_plus_1.cpp \
 	tests/trigger/test_trigger_skipped_wheel.cpp \
 	tests/trigger/test_real_4b11.cpp \
+	tests/trigger/test_trigger_benchmark.cpp \
+	tests/trigger/test_capture_binary_file.cpp \
 	tests/trigger/test_real_4g93.cpp \
 	tests/trigger/test_real_ford_coyote.cpp \
 	tests/trigger/test_real_volkswagen.cpp \
@@ -108,9 +110,13 @@ TESTS_SRC_CPP = \
 	tests/lua/test_lua_Leiderman_Khlystov.cpp \
 	tests/lua/test_can_filter.cpp \
 	tests/lua/test_lua_vin.cpp \
+	tests/lua/test_lua_heap.cpp \
+	tests/lua/test_lua_event_hooks.cpp \
 	tests/test_change_engine_type.cpp \
 	tests/test_big_buffer.cpp \
+	tests/test_engine_sniffer.cpp \
 	tests/system/test_periodic_thread_controller.cpp \
+	tests/system/test_periodic_executor.cpp \
 	tests/test_util.cpp \
 	tests/test_start_stop.cpp \
 	tests/test_hardware_reinit.cpp \
@@ -125,9 +131,11 @@ TESTS_SRC_CPP = \
 	tests/test_launch.cpp \
 	tests/test_fuel_map.cpp \
 	tests/test_gear_detector.cpp \
+	tests/test_engine_configuration_change.cpp \
 	tests/ignition_injection/test_fuel_wall_wetting.cpp \
 	tests/test_one_cylinder_logic.cpp \
 	tests/test_tunerstudio.cpp \
+	tests/test_settings_journal.cpp \
 	tests/test_pwm_generator.cpp \
 	tests/test_log_buffer.cpp \
 	tests/test_event_queue.cpp \
@@ -115,3 +115,63 @@ extern TriggerDecoderBase initState;
 				);
 	}
 }
+
+TEST(AllTriggers, VvtShapesFitVvtStorage) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	for (int mode = VVT_SINGLE_TOOTH; mode <= VVT_HR12DDR_IN; mode++) {
+		vvt_mode_e vvtMode = (vvt_mode_e)mode;
+		trigger_config_s vvtConfig = { getVvtTriggerType(vvtMode), 0, 0 };
+
+		TriggerWaveformVvt shape;
+		shape.initializeTriggerWaveform(FOUR_STROKE_CAM_SENSOR, vvtConfig, /*isCrank*/ false);
+
+		EXPECT_FALSE(shape.shapeDefinitionError) << getVvt_mode_e(vvtMode);
+		EXPECT_LT(shape.getSize(), shape.getMaxSize()) << getVvt_mode_e(vvtMode);
+	}
+}
+
+// fixed point thresholds are not expected to match float right at the boundary
+static bool isNearSyncGapBoundary(float ratio, float boundary) {
+	float resolution = 1.0f / (1 << SYNC_GAP_FIXED_SHIFT);
+	return std::abs(ratio - boundary) <= std::max(1e-4f * boundary, resolution);
+}
+
+TEST_P(AllTriggersFixture, SyncGapFixedPointMatchesFloat) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	trigger_type_e tt = (trigger_type_e)GetParam();
+	trigger_config_s config = { tt, 0, 0 };
+
+	TriggerWaveformFull shape;
+	shape.initializeTriggerWaveform(FOUR_STROKE_CRANK_SENSOR, config);
+	ASSERT_FALSE(shape.shapeDefinitionError) << getTrigger_type_e(tt);
+
+	for (int gapIndex = 0; gapIndex < shape.gapTrackingLength; gapIndex++) {
+		float from = shape.synchronizationRatioFrom[gapIndex];
+		float to = shape.synchronizationRatioTo[gapIndex];
+
+		ASSERT_EQ(std::isnan(from), shape.isSyncGapSkipped(gapIndex)) << getTrigger_type_e(tt) << " gap " << gapIndex;
+		if (std::isnan(from)) {
+			continue;
+		}
+
+		// from tooth at 20000 rpm to tooth at cranking speed, in NT
+		for (uint32_t previous : { 1'000u, 123'457u, 20'000'000u }) {
+			for (float ratio = 0.001; ratio < 1000; ratio *= 1.01) {
+				if (ratio * previous >= (float)UINT32_MAX) {
+					break;
+				}
+				uint32_t current = ratio * previous;
+				float actualRatio = (float)current / previous;
+				if (isNearSyncGapBoundary(actualRatio, from) || isNearSyncGapBoundary(actualRatio, to)) {
+					continue;
+				}
+
+				bool floatResult = current > previous * from && current < previous * to;
+				EXPECT_EQ(floatResult, shape.isSyncGapInRange(gapIndex, current, previous))
+					<< getTrigger_type_e(tt) << " gap " << gapIndex << " " << current << "/" << previous;
+			}
+		}
+	}
+}
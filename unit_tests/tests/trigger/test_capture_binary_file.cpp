@@ -0,0 +1,51 @@
+#include "pch.h"
+
+#include "capture_binary_file.h"
+
+// Binary capture has to replay exactly the same timestamps and states as the CSV it was converted from
+static void assertSameAsCsv(const char *csvFileName) {
+	CaptureBinaryFile binary;
+	ASSERT_TRUE(binary.open(csvFileName)) << "Binary captures are generated by make, see misc/capture_csv_converter";
+
+	FILE *fp = fopen(csvFileName, "r");
+	ASSERT_TRUE(fp != nullptr);
+
+	char buffer[255];
+	int lineIndex = 0;
+	// skip header
+	ASSERT_TRUE(fgets(buffer, sizeof(buffer), fp) != nullptr);
+
+	while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
+		if (buffer[strspn(buffer, " \t\r\n")] == 0) {
+			// blank line has no record
+			continue;
+		}
+		lineIndex++;
+		ASSERT_TRUE(binary.next()) << lineIndex;
+
+		char *token = strtok(buffer, ",");
+		ASSERT_EQ(std::stod(token), binary.timestampSeconds()) << lineIndex;
+
+		for (int column = 0; column < binary.columnCount(); column++) {
+			token = strtok(nullptr, ",");
+			while (token[0] == ' ') {
+				token++;
+			}
+			ASSERT_EQ(token[0] == '1', binary.column(column)) << lineIndex;
+		}
+	}
+	fclose(fp);
+
+	ASSERT_FALSE(binary.next());
+}
+
+TEST(CaptureBinaryFile, sameAsCsv) {
+	assertSameAsCsv("tests/trigger/resources/4b11-running.csv");
+	assertSameAsCsv("tests/trigger/resources/nissan_vq40_cranking-1.csv");
+	assertSameAsCsv("tests/trigger/resources/nick_1.csv");
+}
+
+TEST(CaptureBinaryFile, analogCaptureIsNotConverted) {
+	CaptureBinaryFile binary;
+	ASSERT_FALSE(binary.open("tests/trigger/resources/trigger_adc_1.csv"));
+}
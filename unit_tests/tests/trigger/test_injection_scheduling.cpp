@@ -216,3 +216,84 @@ TEST(injectionScheduling, InjectionNotScheduled) {
 	// We are at 130 degrees now, next tooth 140
 	event.onTriggerTooth(nowNt, 130, 140);
 }
+
+TEST(injectionScheduling, PreparedPulseIsUsed) {
+	StrictMock<MockExecutor> mockExec;
+
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->scheduler.setMockExecutor(&mockExec);
+
+	efitick_t nowNt = 1000000;
+
+	InjectionEvent event;
+	InjectorOutputPin pin;
+	pin.injectorIndex = 0;
+	event.outputs[0] = &pin;
+
+	// Injector model is only invoked once, ahead of the trigger tooth
+	StrictMock<MockInjectorModel2> im;
+	EXPECT_CALL(im, getInjectionDuration(_)).WillOnce(Return(20.0f));
+	engine->module<InjectorModelPrimary>().set(&im);
+
+	engine->rpmCalculator.oneDegreeUs = 100;
+	engine->engineState.injectionMass[0] = 0.01f;
+
+	event.preparePulse();
+
+	{
+		InSequence is;
+
+		float nt5deg = USF2NT(engine->rpmCalculator.oneDegreeUs * 5);
+		efitick_t startTime = nowNt + nt5deg;
+		EXPECT_CALL(mockExec, schedule(testing::NotNull(), _, startTime, _));
+		EXPECT_CALL(mockExec, schedule(testing::NotNull(), _, startTime + MS2NT(20), Property(&action_s::getArgument, Eq(&event))));
+	}
+
+	// Event scheduled at 125 degrees
+	event.injectionStartAngle = 125;
+
+	// We are at 120 degrees now, next tooth 130
+	event.onTriggerTooth(nowNt, 120, 130);
+}
+
+TEST(injectionScheduling, StalePreparedPulseIsRecomputed) {
+	StrictMock<MockExecutor> mockExec;
+
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->scheduler.setMockExecutor(&mockExec);
+
+	efitick_t nowNt = 1000000;
+
+	InjectionEvent event;
+	InjectorOutputPin pin;
+	pin.injectorIndex = 0;
+	event.outputs[0] = &pin;
+
+	StrictMock<MockInjectorModel2> im;
+	EXPECT_CALL(im, getInjectionDuration(_)).WillOnce(Return(20.0f)).WillOnce(Return(10.0f));
+	engine->module<InjectorModelPrimary>().set(&im);
+
+	engine->rpmCalculator.oneDegreeUs = 100;
+	engine->engineState.injectionMass[0] = 0.01f;
+
+	event.preparePulse();
+
+	// fuel mass changed after the pulse was prepared
+	engine->engineState.injectionMass[0] = 0.005f;
+
+	{
+		InSequence is;
+
+		float nt5deg = USF2NT(engine->rpmCalculator.oneDegreeUs * 5);
+		efitick_t startTime = nowNt + nt5deg;
+		EXPECT_CALL(mockExec, schedule(testing::NotNull(), _, startTime, _));
+		// duration from the second model invocation
+		EXPECT_CALL(mockExec, schedule(testing::NotNull(), _, startTime + MS2NT(10), Property(&action_s::getArgument, Eq(&event))));
+	}
+
+	// Event scheduled at 125 degrees
+	event.injectionStartAngle = 125;
+
+	// We are at 120 degrees now, next tooth 130
+	event.onTriggerTooth(nowNt, 120, 130);
+}
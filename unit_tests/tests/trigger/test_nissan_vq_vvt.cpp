@@ -81,7 +81,7 @@ TEST(nissan, vq_vvt) {
 	int cyclesCount = 48;
 
 	{
-		static TriggerWaveform crank;
+		static TriggerWaveformFull crank;
 		initializeNissanVQ35crank(&crank);
 
 		scheduleTriggerEvents(&crank,
@@ -93,7 +93,7 @@ TEST(nissan, vq_vvt) {
 	angle_t testVvtOffset = 13;
 
 	{
-		static TriggerWaveform vvt;
+		static TriggerWaveformVvt vvt;
 		initializeNissanVQvvt(&vvt);
 
 		scheduleTriggerEvents(&vvt,
@@ -105,7 +105,7 @@ TEST(nissan, vq_vvt) {
 	}
 
 	{
-		static TriggerWaveform vvt;
+		static TriggerWaveformVvt vvt;
 		initializeNissanVQvvt(&vvt);
 
 		scheduleTriggerEvents(&vvt,
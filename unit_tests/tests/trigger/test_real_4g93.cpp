@@ -47,7 +47,7 @@ TEST(real4g93, cranking) {
 
   TriggerDecoderBase& vvtDecoder = tc->vvtState[/*bankIndex*/0][/*camIndex*/0];
 
-		float vvtSyncGapRatio = vvtDecoder.triggerSyncGapRatio;
+		float vvtSyncGapRatio = vvtDecoder.getSyncGapRatio();
 		float gapRatio = gapRatios[idx < 12 ? 0 : 1][gapRatioIndices[idx % 12]];
 		if (isnan(gapRatio)) {
 			EXPECT_TRUE(isnan(vvtSyncGapRatio));
@@ -0,0 +1,278 @@
+/**
+ * @file test_trigger_benchmark.cpp
+ *
+ * Trigger decoding throughput over recorded captures. Replays each capture from memory through
+ * hwHandleShaftSignal/hwHandleVvtCamSignal with fuel and spark scheduling on.
+ *
+ * Disabled by default since numbers only make sense on a quiet machine, see run_trigger_benchmark.sh
+ * Results are written to TRIGGER_BENCHMARK_RESULTS, copy them into TRIGGER_BENCHMARK_BASELINE to
+ * update the baseline. Captures without timing in the baseline are only reported.
+ *
+ * Allocations are counted with malloc() granularity only in sanitizer build, otherwise just operator new.
+ */
+
+#include "pch.h"
+#include "trigger_capture.h"
+
+#include <chrono>
+#include <map>
+#include <new>
+#include <string>
+
+#define TRIGGER_BENCHMARK_BASELINE "tests/trigger/resources/trigger_benchmark_baseline.txt"
+#define TRIGGER_BENCHMARK_RESULTS "test_results/trigger_benchmark.txt"
+
+// replay each capture until we have at least this many edges
+#define TRIGGER_BENCHMARK_MIN_EDGES 200'000
+// setTimeAndInvokeEventsUs() takes int
+#define TRIGGER_BENCHMARK_MAX_SECONDS 2000
+// how much slower than baseline is still fine
+#define TRIGGER_BENCHMARK_TOLERANCE 1.25
+
+#if defined(__SANITIZE_ADDRESS__)
+#define TRIGGER_BENCHMARK_COUNT_ALLOCATIONS 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define TRIGGER_BENCHMARK_COUNT_ALLOCATIONS 1
+#endif
+#endif
+
+#if TRIGGER_BENCHMARK_COUNT_ALLOCATIONS
+// sanitizer/allocator_interface.h does not come with all gcc versions
+extern "C" int __sanitizer_install_malloc_and_free_hooks(
+	void (*malloc_hook)(const volatile void *, size_t),
+	void (*free_hook)(const volatile void *));
+#endif
+
+static bool isCountingAllocations = false;
+static int allocationCount = 0;
+
+#if TRIGGER_BENCHMARK_COUNT_ALLOCATIONS
+static void onMalloc(const volatile void *, size_t) {
+	if (isCountingAllocations) {
+		allocationCount++;
+	}
+}
+
+static void onFree(const volatile void *) {
+}
+#else
+// Without sanitizer only C++ allocations are seen, malloc() calls are not counted
+static void *countedNew(std::size_t size) {
+	if (isCountingAllocations) {
+		allocationCount++;
+	}
+	void *p = malloc(size == 0 ? 1 : size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void *operator new(std::size_t size) {
+	return countedNew(size);
+}
+
+void *operator new[](std::size_t size) {
+	return countedNew(size);
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+	free(p);
+}
+#endif
+
+/**
+ * Hot path is supposed to be allocation-free, count allocations made while replaying.
+ * Sanitizer build counts every malloc() through allocator hooks which are installed only once
+ * benchmark runs, other tests keep regular allocator. Other builds replace global operator new
+ * and only count C++ allocations.
+ * @return true if allocations made with malloc() are counted as well
+ */
+static bool installAllocationCounter() {
+#if TRIGGER_BENCHMARK_COUNT_ALLOCATIONS
+	static bool isInstalled = __sanitizer_install_malloc_and_free_hooks(onMalloc, onFree) != 0;
+	return isInstalled;
+#else
+	return false;
+#endif
+}
+
+struct TriggerBenchmarkCapture {
+	const char *name;
+	const char *fileName;
+	size_t triggerCount;
+	size_t vvtCount;
+	engine_type_e engineType;
+	// TT_TOOTHED_WHEEL here means trigger defined by engine type
+	trigger_type_e triggerType;
+	vvt_mode_e vvtMode;
+	const int *vvtColumnIndeces;
+	bool twoBanksSingleCamMode;
+};
+
+static const TriggerBenchmarkCapture captures[] = {
+	{ "4b11_running", "tests/trigger/resources/4b11-running.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_36_2_1, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "4g93_cranking", "tests/trigger/resources/4g93-cranking.csv", 1, 1,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_MITSU_4G63_CRANK, VVT_MITSUBISHI_4G63, NORMAL_ORDER, true },
+	{ "arctic_cat", "tests/trigger/resources/arctic-cat.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_ARCTIC_CAT, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "bqs_longer", "tests/trigger/resources/BQS-longer.csv", 1, 0,
+		engine_type_e::ET_BOSCH_QUICK_START, trigger_type_e::TT_TOOTHED_WHEEL, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "cas_24_plus_1", "tests/trigger/resources/cas_nissan_24_plus_1.csv", 1, 1,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_12_TOOTH_CRANK, VVT_SINGLE_TOOTH, NORMAL_ORDER, true },
+	{ "ford_coyote_intake", "tests/trigger/resources/ford-coyote-intake-cam.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_VVT_FORD_COYOTE, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "gm_24x_cranking", "tests/trigger/resources/gm_24x_cranking.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_GM_24x_5, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "honda_k20_cranking", "tests/trigger/resources/civic-K20-cranking.csv", 1, 2,
+		engine_type_e::HONDA_K, trigger_type_e::TT_TOOTHED_WHEEL, VVT_INACTIVE, REVERSE_ORDER, false },
+	{ "honda_k24a2_cranking", "tests/trigger/resources/cranking_honda_k24a2_no_plugs.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_HONDA_K_CRANK_12_1, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "miata_nb2_cranking", "tests/trigger/resources/nb2-cranking-good.csv", 1, 1,
+		engine_type_e::MAZDA_MIATA_NB2, trigger_type_e::TT_TOOTHED_WHEEL, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "nissan_hr12_running", "tests/trigger/resources/nissan-HR12DDR-with-spark-plugs-4-seconds.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_NISSAN_HR, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "nissan_hr12_cam", "tests/trigger/resources/hr12-vvt-in-16s.csv", 1, 0,
+		engine_type_e::TEST_ENGINE, trigger_type_e::TT_NISSAN_HR_CAM_IN, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "nissan_vq40_cranking", "tests/trigger/resources/nissan_vq40_cranking-1.csv", 1, 2,
+		engine_type_e::HELLEN_121_NISSAN_6_CYL, trigger_type_e::TT_TOOTHED_WHEEL, VVT_INACTIVE, NORMAL_ORDER, true },
+	{ "vw_60_2", "tests/trigger/resources/nick_1.csv", 1, 0,
+		engine_type_e::VW_ABA, trigger_type_e::TT_60_2_WRONG_POLARITY, VVT_INACTIVE, NORMAL_ORDER, true },
+};
+
+struct TriggerBenchmarkBaseline {
+	// edges in one pass over the capture, does not depend on machine
+	size_t edges;
+	// zero if not measured yet
+	double nsPerTooth;
+};
+
+static std::map<std::string, TriggerBenchmarkBaseline> readBaseline() {
+	std::map<std::string, TriggerBenchmarkBaseline> result;
+	FILE *fp = fopen(TRIGGER_BENCHMARK_BASELINE, "r");
+	if (fp == nullptr) {
+		return result;
+	}
+	char line[255];
+	while (fgets(line, sizeof(line), fp) != nullptr) {
+		char name[128];
+		unsigned long edges;
+		double nsPerTooth = 0;
+		if (line[0] != '#' && sscanf(line, "%127s %lu %lf", name, &edges, &nsPerTooth) >= 2) {
+			result[name] = { edges, nsPerTooth };
+		}
+	}
+	fclose(fp);
+	return result;
+}
+
+struct TriggerBenchmarkResults {
+	FILE *fp;
+
+	TriggerBenchmarkResults() {
+		fp = fopen(TRIGGER_BENCHMARK_RESULTS, "w+");
+		if (fp != nullptr) {
+			fprintf(fp, "# capture edges nsPerTooth edgesPerSecond\n");
+		}
+	}
+
+	~TriggerBenchmarkResults() {
+		if (fp != nullptr) {
+			fclose(fp);
+		}
+	}
+};
+
+class TriggerBenchmark : public ::testing::TestWithParam<TriggerBenchmarkCapture> {
+};
+
+INSTANTIATE_TEST_SUITE_P(
+	Captures,
+	TriggerBenchmark,
+	::testing::ValuesIn(captures),
+	[](const ::testing::TestParamInfo<TriggerBenchmarkCapture>& info) {
+		return std::string(info.param.name);
+	}
+);
+
+TEST_P(TriggerBenchmark, DISABLED_replay) {
+	static TriggerBenchmarkResults results;
+	static std::map<std::string, TriggerBenchmarkBaseline> baseline = readBaseline();
+
+	const TriggerBenchmarkCapture& c = GetParam();
+
+	TriggerCapture capture;
+	capture.load(c.fileName, c.triggerCount, c.vvtCount, NORMAL_ORDER, c.vvtColumnIndeces);
+	ASSERT_TRUE(capture.size() > 0) << c.fileName;
+	capture.twoBanksSingleCamMode = c.twoBanksSingleCamMode;
+
+	EngineTestHelper eth(c.engineType);
+	engineConfiguration->isInjectionEnabled = true;
+	engineConfiguration->isIgnitionEnabled = true;
+	engineConfiguration->alwaysInstantRpm = true;
+	if (c.vvtMode != VVT_INACTIVE) {
+		engineConfiguration->vvtMode[0] = c.vvtMode;
+	}
+	if (c.triggerType != trigger_type_e::TT_TOOTHED_WHEEL) {
+		eth.setTriggerType(c.triggerType);
+	}
+
+	// leave a second of silence between passes so that each pass starts with engine stopped
+	double passLengthUs = (capture.durationSeconds() + 1) * 1e6;
+	int passes = (int)((TRIGGER_BENCHMARK_MIN_EDGES + capture.size() - 1) / capture.size());
+	passes = minI(passes, (int)(TRIGGER_BENCHMARK_MAX_SECONDS * 1e6 / passLengthUs));
+	passes = maxI(passes, 1);
+
+	bool isCountingMalloc = installAllocationCounter();
+
+	size_t edges = 0;
+	allocationCount = 0;
+	isCountingAllocations = true;
+	auto start = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < passes; pass++) {
+		edges += capture.replay(&eth, pass * passLengthUs - capture.startUs() + 1e6);
+	}
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	isCountingAllocations = false;
+
+	double elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	double nsPerTooth = elapsedNs / edges;
+	double edgesPerSecond = edges * 1e9 / elapsedNs;
+
+	printf("%s: %d edges in %d passes, %.1f ns per tooth, %.0f edges per second\n",
+		c.name, (int)edges, passes, nsPerTooth, edgesPerSecond);
+	if (results.fp != nullptr) {
+		fprintf(results.fp, "%s %d %.1f %.0f\n", c.name, (int)capture.size(), nsPerTooth, edgesPerSecond);
+		fflush(results.fp);
+	}
+
+	EXPECT_EQ(0, allocationCount) << "trigger hot path is expected to be allocation-free";
+	if (!isCountingMalloc) {
+		printf("%s: only operator new is counted, malloc() is counted in sanitizer build\n", c.name);
+	}
+
+	auto it = baseline.find(c.name);
+	ASSERT_TRUE(it != baseline.end()) << "no baseline for " << c.name;
+	// different number of edges means capture or its loading has changed, timing is not comparable
+	ASSERT_EQ(it->second.edges, capture.size()) << "edges per pass";
+	if (it->second.nsPerTooth <= 0) {
+		// timing depends on machine, nothing to compare against until it was measured on the reference one
+		printf("%s: no timing baseline, see run_trigger_benchmark.sh\n", c.name);
+		return;
+	}
+	EXPECT_LT(nsPerTooth, it->second.nsPerTooth * TRIGGER_BENCHMARK_TOLERANCE) << "regression against baseline " << it->second.nsPerTooth;
+}
@@ -152,7 +152,7 @@ static void testTriggerDecoder2(const char *msg, engine_type_e type, int synchPo
 
 	ASSERT_EQ(synchPointIndex, t->getTriggerWaveformSynchPointIndex()) << "synchPointIndex " << msg;
 	if (!std::isnan(expectedGapRatio)) {
-		ASSERT_NEAR(expectedGapRatio, initState.triggerSyncGapRatio, 0.001) << "actual gap ratio";
+		ASSERT_NEAR(expectedGapRatio, initState.getSyncGapRatio(), 0.001) << "actual gap ratio";
     }
 }
 
@@ -31,12 +31,9 @@ struct MockTriggerDecoder : public TriggerDecoderBase {
 	MOCK_METHOD(void, onTooManyTeeth, (int actual, int expected), (override));
 };
 
-static auto makeTriggerShape(operation_mode_e mode, const TriggerConfiguration& config) {
-	// huh? do we return local method instance? how come it's not a SegmFault? is it not allocated on stack?!
-	TriggerWaveform shape;
+// waveform is not copyable, see TriggerWaveform
+static void initTriggerShape(TriggerWaveformFull& shape, operation_mode_e mode, const TriggerConfiguration& config) {
 	shape.initializeTriggerWaveform(mode, config.TriggerType);
-
-	return shape;
 }
 
 #define doTooth(dut, shape, cfg, t) dut.decodeTriggerEvent("", shape, nullptr, cfg, SHAFT_PRIMARY_RISING, t)
@@ -46,7 +43,8 @@ TEST(TriggerDecoder, FindsFirstSyncPoint) {
 	cfg.update();
 	engineConfiguration = nullptr;
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CAM_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CAM_SENSOR, cfg);
 
 	efitick_t t = 0;
 
@@ -89,7 +87,8 @@ TEST(TriggerDecoder, FindsSyncPointMultipleRevolutions) {
 	MockTriggerConfiguration cfg({trigger_type_e::TT_TOOTHED_WHEEL, 4, 1});
 	cfg.update();
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CAM_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CAM_SENSOR, cfg);
 
 	efitick_t t = 0;
 
@@ -139,7 +138,8 @@ TEST(TriggerDecoder, TooManyTeeth_CausesError) {
 	MockTriggerConfiguration cfg({trigger_type_e::TT_TOOTHED_WHEEL, 4, 1});
 	cfg.update();
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CAM_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CAM_SENSOR, cfg);
 
 	efitick_t t = 0;
 
@@ -217,7 +217,8 @@ TEST(TriggerDecoder, NotEnoughTeeth_CausesError) {
 	MockTriggerConfiguration cfg({trigger_type_e::TT_TOOTHED_WHEEL, 4, 1});
 	cfg.update();
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CAM_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CAM_SENSOR, cfg);
 
 	efitick_t t = 0;
 
@@ -294,7 +295,8 @@ TEST(TriggerDecoder, PrimaryDecoderNoDisambiguation) {
 	MockTriggerConfiguration cfg({trigger_type_e::TT_TOOTHED_WHEEL, 4, 1});
 	cfg.update();
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CAM_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CAM_SENSOR, cfg);
 
 	efitick_t t = 0;
 
@@ -325,7 +327,8 @@ TEST(TriggerDecoder, PrimaryDecoderNeedsDisambiguation) {
 	MockTriggerConfiguration cfg({trigger_type_e::TT_TOOTHED_WHEEL, 4, 1});
 	cfg.update();
 
-	auto shape = makeTriggerShape(FOUR_STROKE_CRANK_SENSOR, cfg);
+	TriggerWaveformFull shape;
+	initTriggerShape(shape, FOUR_STROKE_CRANK_SENSOR, cfg);
 
 	efitick_t t = 0;
 
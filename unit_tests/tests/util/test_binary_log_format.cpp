@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "binary_log_format.h"
+
+TEST(util, binaryLogConversions) {
+	const char* format = "msg`rpm %d map %.2f name %s`";
+	LogConversion conversion;
+
+	ASSERT_TRUE(nextLogConversion(format, conversion));
+	EXPECT_EQ(LogArgType::Int, conversion.type);
+	EXPECT_EQ(std::string("%d"), std::string(conversion.start, conversion.end));
+
+	ASSERT_TRUE(nextLogConversion(format, conversion));
+	EXPECT_EQ(LogArgType::Float, conversion.type);
+	EXPECT_EQ(std::string("%.2f"), std::string(conversion.start, conversion.end));
+
+	ASSERT_TRUE(nextLogConversion(format, conversion));
+	EXPECT_EQ(LogArgType::String, conversion.type);
+	EXPECT_EQ(0, conversion.starCount);
+
+	EXPECT_FALSE(nextLogConversion(format, conversion));
+}
+
+TEST(util, binaryLogConversionsEscapesAndStars) {
+	const char* format = "100%% %-*.*lu%c %";
+	LogConversion conversion;
+
+	ASSERT_TRUE(nextLogConversion(format, conversion));
+	EXPECT_EQ(LogArgType::Int, conversion.type);
+	EXPECT_EQ(2, conversion.starCount);
+	EXPECT_EQ(std::string("%-*.*lu"), std::string(conversion.start, conversion.end));
+
+	ASSERT_TRUE(nextLogConversion(format, conversion));
+	EXPECT_EQ(LogArgType::Int, conversion.type);
+	EXPECT_EQ(0, conversion.starCount);
+
+	// dangling '%' is not a conversion
+	EXPECT_FALSE(nextLogConversion(format, conversion));
+}